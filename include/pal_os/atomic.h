@@ -0,0 +1,474 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================
+// Macros and Constants
+// ============================
+/**
+ * @brief Set to 1 to implement read-modify-write operations with critical sections instead of native atomics.
+ * @note Enabled by default on freeRTOS targets whose compiler reports no lock-free 32-bit or pointer atomics.
+ */
+#ifndef PAL_OS_ATOMIC_CRITICAL_SECTION
+#if defined PAL_OS_FREERTOS && (!defined __GCC_ATOMIC_INT_LOCK_FREE || __GCC_ATOMIC_INT_LOCK_FREE < 2 || __GCC_ATOMIC_POINTER_LOCK_FREE < 2)
+#define PAL_OS_ATOMIC_CRITICAL_SECTION 1
+#else
+#define PAL_OS_ATOMIC_CRITICAL_SECTION 0
+#endif
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+/**
+ * @brief Memory ordering constraints, with the same meaning as the C11 memory orders.
+ */
+typedef enum
+{
+	PAL_ATOMIC_RELAXED = __ATOMIC_RELAXED,	//!< Atomicity only, no ordering
+	PAL_ATOMIC_ACQUIRE = __ATOMIC_ACQUIRE,	//!< Later accesses cannot move before the operation
+	PAL_ATOMIC_RELEASE = __ATOMIC_RELEASE,	//!< Earlier accesses cannot move after the operation
+	PAL_ATOMIC_ACQ_REL = __ATOMIC_ACQ_REL,	//!< Both acquire and release
+	PAL_ATOMIC_SEQ_CST = __ATOMIC_SEQ_CST,	//!< Acquire and release, plus a single total order of all sequentially consistent operations
+} pal_atomic_order_t;
+
+// ============================
+// Function Declarations
+// ============================
+#ifdef PAL_OS_FREERTOS
+/**
+ * @brief Enters the critical section protecting the emulated read-modify-write operations.
+ *
+ * @return Interrupt state to be passed to pal_atomic_unlock.
+ * @note Safe to call from both tasks and ISRs. Only used when PAL_OS_ATOMIC_CRITICAL_SECTION is 1.
+ */
+uint32_t pal_atomic_lock(void);
+
+/**
+ * @brief Leaves the critical section entered by pal_atomic_lock.
+ *
+ * @param[in] state Value returned by the matching pal_atomic_lock.
+ */
+void pal_atomic_unlock(uint32_t state);
+#endif
+
+/**
+ * @brief Failure ordering used by the compare and exchange operations for a given success ordering.
+ *
+ * @param[in] order Success ordering.
+ * @return The strongest ordering allowed for a failed compare and exchange.
+ */
+static inline int pal_atomic_failure_order(pal_atomic_order_t order)
+{
+	int failure = order;
+	if (PAL_ATOMIC_RELEASE == order)
+	{
+		failure = PAL_ATOMIC_RELAXED;
+	}
+	else if (PAL_ATOMIC_ACQ_REL == order)
+	{
+		failure = PAL_ATOMIC_ACQUIRE;
+	}
+	return failure;
+}
+
+/**
+ * @brief Atomically loads a 32-bit value.
+ *
+ * @param[in] ptr Pointer to the value.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_RELEASE or PAL_ATOMIC_ACQ_REL.
+ * @return The loaded value.
+ */
+static inline uint32_t pal_atomic_u32_load(const uint32_t *ptr, pal_atomic_order_t order) { return __atomic_load_n(ptr, order); }
+
+/**
+ * @brief Atomically stores a 32-bit value.
+ *
+ * @param[out] ptr Pointer to the value.
+ * @param[in] value Value to store.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_ACQUIRE or PAL_ATOMIC_ACQ_REL.
+ */
+static inline void pal_atomic_u32_store(uint32_t *ptr, uint32_t value, pal_atomic_order_t order) { __atomic_store_n(ptr, value, order); }
+
+/**
+ * @brief Atomically replaces a 32-bit value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value New value.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline uint32_t pal_atomic_u32_exchange(uint32_t *ptr, uint32_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	uint32_t old   = *ptr;
+	*ptr		   = value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_exchange_n(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically replaces a 32-bit value if it holds the expected one.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in,out] expected Expected value, updated with the current one on failure.
+ * @param[in] desired Value stored on success.
+ * @param[in] order Memory ordering on success. The failure ordering is the strongest one allowed.
+ * @return true if the value was replaced, false otherwise.
+ */
+static inline bool pal_atomic_u32_compare_exchange(uint32_t *ptr, uint32_t *expected, uint32_t desired, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state	  = pal_atomic_lock();
+	bool	 replaced = *ptr == *expected;
+	if (replaced)
+	{
+		*ptr = desired;
+	}
+	else
+	{
+		*expected = *ptr;
+	}
+	pal_atomic_unlock(state);
+	(void)order;
+	return replaced;
+#else
+	return __atomic_compare_exchange_n(ptr, expected, desired, false, order, pal_atomic_failure_order(order));
+#endif
+}
+
+/**
+ * @brief Atomically adds to a 32-bit value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Value to add.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline uint32_t pal_atomic_u32_fetch_add(uint32_t *ptr, uint32_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	uint32_t old   = *ptr;
+	*ptr		   = old + value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_add(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically subtracts from a 32-bit value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Value to subtract.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline uint32_t pal_atomic_u32_fetch_sub(uint32_t *ptr, uint32_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	uint32_t old   = *ptr;
+	*ptr		   = old - value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_sub(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically sets bits of a 32-bit value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Bits to set.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline uint32_t pal_atomic_u32_fetch_or(uint32_t *ptr, uint32_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	uint32_t old   = *ptr;
+	*ptr		   = old | value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_or(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically masks a 32-bit value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Bits to keep.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline uint32_t pal_atomic_u32_fetch_and(uint32_t *ptr, uint32_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	uint32_t old   = *ptr;
+	*ptr		   = old & value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_and(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically loads a size value.
+ *
+ * @param[in] ptr Pointer to the value.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_RELEASE or PAL_ATOMIC_ACQ_REL.
+ * @return The loaded value.
+ */
+static inline size_t pal_atomic_size_load(const size_t *ptr, pal_atomic_order_t order) { return __atomic_load_n(ptr, order); }
+
+/**
+ * @brief Atomically stores a size value.
+ *
+ * @param[out] ptr Pointer to the value.
+ * @param[in] value Value to store.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_ACQUIRE or PAL_ATOMIC_ACQ_REL.
+ */
+static inline void pal_atomic_size_store(size_t *ptr, size_t value, pal_atomic_order_t order) { __atomic_store_n(ptr, value, order); }
+
+/**
+ * @brief Atomically replaces a size value if it holds the expected one.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in,out] expected Expected value, updated with the current one on failure.
+ * @param[in] desired Value stored on success.
+ * @param[in] order Memory ordering on success. The failure ordering is the strongest one allowed.
+ * @return true if the value was replaced, false otherwise.
+ */
+static inline bool pal_atomic_size_compare_exchange(size_t *ptr, size_t *expected, size_t desired, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state	  = pal_atomic_lock();
+	bool	 replaced = *ptr == *expected;
+	if (replaced)
+	{
+		*ptr = desired;
+	}
+	else
+	{
+		*expected = *ptr;
+	}
+	pal_atomic_unlock(state);
+	(void)order;
+	return replaced;
+#else
+	return __atomic_compare_exchange_n(ptr, expected, desired, false, order, pal_atomic_failure_order(order));
+#endif
+}
+
+/**
+ * @brief Atomically adds to a size value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Value to add.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline size_t pal_atomic_size_fetch_add(size_t *ptr, size_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	size_t	 old   = *ptr;
+	*ptr		   = old + value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_add(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically subtracts from a size value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Value to subtract.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline size_t pal_atomic_size_fetch_sub(size_t *ptr, size_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	size_t	 old   = *ptr;
+	*ptr		   = old - value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_sub(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically sets bits of a size value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Bits to set.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline size_t pal_atomic_size_fetch_or(size_t *ptr, size_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	size_t	 old   = *ptr;
+	*ptr		   = old | value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_or(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically masks a size value.
+ *
+ * @param[in,out] ptr Pointer to the value.
+ * @param[in] value Bits to keep.
+ * @param[in] order Memory ordering.
+ * @return The previous value.
+ */
+static inline size_t pal_atomic_size_fetch_and(size_t *ptr, size_t value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	size_t	 old   = *ptr;
+	*ptr		   = old & value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_fetch_and(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically loads a pointer.
+ *
+ * @param[in] ptr Pointer to the pointer.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_RELEASE or PAL_ATOMIC_ACQ_REL.
+ * @return The loaded pointer.
+ */
+static inline void *pal_atomic_ptr_load(void *const *ptr, pal_atomic_order_t order) { return __atomic_load_n(ptr, order); }
+
+/**
+ * @brief Atomically stores a pointer.
+ *
+ * @param[out] ptr Pointer to the pointer.
+ * @param[in] value Pointer to store.
+ * @param[in] order Memory ordering. Cannot be PAL_ATOMIC_ACQUIRE or PAL_ATOMIC_ACQ_REL.
+ */
+static inline void pal_atomic_ptr_store(void **ptr, void *value, pal_atomic_order_t order) { __atomic_store_n(ptr, value, order); }
+
+/**
+ * @brief Atomically replaces a pointer.
+ *
+ * @param[in,out] ptr Pointer to the pointer.
+ * @param[in] value New pointer.
+ * @param[in] order Memory ordering.
+ * @return The previous pointer.
+ */
+static inline void *pal_atomic_ptr_exchange(void **ptr, void *value, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state = pal_atomic_lock();
+	void	*old   = *ptr;
+	*ptr		   = value;
+	pal_atomic_unlock(state);
+	(void)order;
+	return old;
+#else
+	return __atomic_exchange_n(ptr, value, order);
+#endif
+}
+
+/**
+ * @brief Atomically replaces a pointer if it holds the expected one.
+ *
+ * @param[in,out] ptr Pointer to the pointer.
+ * @param[in,out] expected Expected pointer, updated with the current one on failure.
+ * @param[in] desired Pointer stored on success.
+ * @param[in] order Memory ordering on success. The failure ordering is the strongest one allowed.
+ * @return true if the pointer was replaced, false otherwise.
+ */
+static inline bool pal_atomic_ptr_compare_exchange(void **ptr, void **expected, void *desired, pal_atomic_order_t order)
+{
+#if PAL_OS_ATOMIC_CRITICAL_SECTION
+	uint32_t state	  = pal_atomic_lock();
+	bool	 replaced = *ptr == *expected;
+	if (replaced)
+	{
+		*ptr = desired;
+	}
+	else
+	{
+		*expected = *ptr;
+	}
+	pal_atomic_unlock(state);
+	(void)order;
+	return replaced;
+#else
+	return __atomic_compare_exchange_n(ptr, expected, desired, false, order, pal_atomic_failure_order(order));
+#endif
+}
+
+/**
+ * @brief Memory fence.
+ *
+ * @param[in] order Memory ordering enforced between the accesses before and after the fence.
+ */
+static inline void pal_atomic_fence(pal_atomic_order_t order) { __atomic_thread_fence(order); }
+
+/**
+ * @brief Hints the CPU that the caller is spinning on a shared location.
+ *
+ * @note Lowers power usage and the cost of the spin for the sibling hardware thread, it is not a scheduling point.
+ */
+static inline void pal_cpu_relax(void)
+{
+#if defined __x86_64__ || defined __i386__
+	__builtin_ia32_pause();
+#elif defined __aarch64__ || (defined __arm__ && __ARM_ARCH >= 7)
+	__asm__ __volatile__("yield" ::: "memory");
+#else
+	__asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#include <stdint.h>
+#ifdef PAL_OS_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#endif
+#include "pal_os/common.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#define PAL_BARRIER_SERIAL_THREAD 1	 //!< Returned by pal_barrier_wait to exactly one thread of every round
+
+#ifdef PAL_OS_LINUX
+#define PAL_BARRIER_INITIALIZER(count) {(count), 0, 0}	//!< Static initializer for a barrier
+#elif defined PAL_OS_FREERTOS
+#define PAL_BARRIER_INITIALIZER(count) {NULL, (count), 0, 0}  //!< Static initializer for a barrier, the event group is created on first use
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+#ifdef PAL_OS_LINUX
+struct pal_barrier_s
+{
+	uint32_t count;		  //!< Number of threads taking part in every round
+	uint32_t arrived;	  //!< Number of threads arrived in the current round
+	uint32_t generation;  //!< Futex word, incremented when a round completes
+};
+#elif defined PAL_OS_FREERTOS
+struct pal_barrier_s
+{
+	EventGroupHandle_t group;		//!< Event group the waiters block on, one bit per round parity
+	uint32_t		   count;		//!< Number of tasks taking part in every round
+	uint32_t		   arrived;		//!< Number of tasks arrived in the current round
+	uint32_t		   generation;	//!< Incremented when a round completes
+};
+#endif
+typedef struct pal_barrier_s pal_barrier_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a cyclic barrier.
+ *
+ * @param[out] barrier Pointer to the barrier to be created.
+ * @param[in] count Number of threads that must call pal_barrier_wait to complete a round. Cannot be 0.
+ * @return 0 on success, or -1 on failure.
+ * @note A barrier defined with PAL_BARRIER_INITIALIZER does not need to be created.
+ */
+int pal_barrier_create(pal_barrier_t *barrier, size_t count);
+
+/**
+ * @brief Blocks until count threads have reached the barrier.
+ *
+ * @param[in] barrier Pointer to the barrier.
+ * @return PAL_BARRIER_SERIAL_THREAD for the thread that completed the round, 0 for the other threads, or -1 on failure.
+ * @note The barrier is reset when a round completes, so it can be reused by the same threads right away.
+ */
+int pal_barrier_wait(pal_barrier_t *barrier);
+
+/**
+ * @brief Destroys the barrier.
+ *
+ * @param[in,out] barrier Pointer to the barrier to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_barrier_destroy(pal_barrier_t *barrier);
+
+#ifdef __cplusplus
+}
+#endif
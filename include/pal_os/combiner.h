@@ -0,0 +1,96 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pal_os/mutex.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifndef PAL_COMBINER_SPIN_COUNT
+#define PAL_COMBINER_SPIN_COUNT 128	 //!< Polls of the completion flag before a waiter blocks on the combiner lock
+#endif
+
+#ifndef PAL_COMBINER_MAX_PASSES
+#define PAL_COMBINER_MAX_PASSES 8  //!< Batches collected by a combiner before it hands the lock over
+#endif
+
+#define PAL_COMBINER_INITIALIZER(object) {PAL_MUTEX_INITIALIZER, NULL, (object)}  //!< Static initializer for a combiner
+
+// ============================
+// Type Definitions
+// ============================
+/**
+ * @brief Operation applied to the shared object.
+ * @param object Object protected by the combiner.
+ * @param arg Argument of the operation, also used to return results.
+ */
+typedef void (*pal_combiner_func_t)(void *object, void *arg);
+
+/**
+ * @brief Publication record of an operation, owned by the calling thread for the duration of pal_combiner_execute.
+ */
+struct pal_combiner_op_s
+{
+	struct pal_combiner_op_s *next;	 //!< Next pending operation
+	pal_combiner_func_t		  func;	 //!< Operation to apply
+	void					 *arg;	 //!< Argument of the operation
+	uint32_t				  done;	 //!< Set by the combiner once the operation has been applied
+};
+typedef struct pal_combiner_op_s pal_combiner_op_t;
+
+struct pal_combiner_s
+{
+	pal_mutex_t		   lock;	 //!< Held by the thread currently applying operations
+	pal_combiner_op_t *pending;	 //!< Stack of published operations not yet applied
+	void			  *object;	 //!< Object protected by the combiner
+};
+typedef struct pal_combiner_s pal_combiner_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a flat-combining executor for a shared object.
+ *
+ * @param[out] combiner Pointer to the combiner to be created.
+ * @param[in] object Object passed to every operation.
+ * @return 0 on success, or -1 on failure.
+ * @note A combiner defined with PAL_COMBINER_INITIALIZER does not need to be created.
+ */
+int pal_combiner_create(pal_combiner_t *combiner, void *object);
+
+/**
+ * @brief Applies an operation to the shared object and waits for its completion.
+ *
+ * @param[in] combiner Pointer to the combiner.
+ * @param[in] op Publication record, usually on the caller's stack. It can be reused once the call returns.
+ * @param[in] func Operation to apply.
+ * @param[in] arg Argument of the operation.
+ * @return 0 once the operation has been applied, or -1 on failure.
+ * @note Operations are applied one at a time, but not necessarily by the calling thread: whichever thread holds the combiner lock
+ * applies every pending operation in a batch, so the object stays in its cache. func must not block or call back into the combiner.
+ */
+int pal_combiner_execute(pal_combiner_t *combiner, pal_combiner_op_t *op, pal_combiner_func_t func, void *arg);
+
+/**
+ * @brief Destroys the combiner.
+ *
+ * @param[in,out] combiner Pointer to the combiner to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_combiner_destroy(pal_combiner_t *combiner);
+
+#ifdef __cplusplus
+}
+#endif
@@ -18,6 +18,10 @@ extern "C"
 #ifndef PAL_OS_RAM_ATTR
 #define PAL_OS_RAM_ATTR
 #endif
+
+#ifndef PAL_OS_CACHE_LINE_SIZE
+#define PAL_OS_CACHE_LINE_SIZE 64  //!< Alignment used to keep independently written data on separate cache lines
+#endif
 // ============================
 // Type Definitions
 // ============================
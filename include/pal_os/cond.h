@@ -0,0 +1,112 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#ifdef PAL_OS_LINUX
+#include <stdint.h>
+#elif defined PAL_OS_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
+#include "pal_os/common.h"
+#include "pal_os/mutex.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifdef PAL_OS_LINUX
+#define PAL_COND_INITIALIZER {0, 0}	 //!< Static initializer for a condition variable
+#elif defined PAL_OS_FREERTOS
+#define PAL_COND_INITIALIZER {NULL, NULL, 0}  //!< Static initializer for a condition variable, the semaphores are created on first use
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+#ifdef PAL_OS_LINUX
+struct pal_cond_s
+{
+	uint32_t seq;	   //!< Futex word, incremented by every signal and broadcast
+	uint32_t waiters;  //!< Number of threads blocked on the condition variable
+};
+#elif defined PAL_OS_FREERTOS
+struct pal_cond_s
+{
+	SemaphoreHandle_t sem;		//!< Counting semaphore the waiters block on
+	SemaphoreHandle_t lock;		//!< Mutex protecting the waiters counter
+	UBaseType_t		  waiters;	//!< Number of tasks blocked on the condition variable
+};
+#endif
+typedef struct pal_cond_s pal_cond_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a new condition variable.
+ *
+ * @param[out] cond Pointer to the condition variable to be created.
+ * @return 0 on success, or -1 on failure.
+ * @note A condition variable defined with PAL_COND_INITIALIZER does not need to be created.
+ */
+int pal_cond_create(pal_cond_t *cond);
+
+/**
+ * @brief Atomically releases the mutex and waits for the condition variable to be signaled.
+ *
+ * @param[in] cond Pointer to the condition variable.
+ * @param[in] mutex Pointer to the mutex, locked by the caller. It is locked again before returning.
+ * @return 0 on success, or -1 on failure.
+ * @note Wakeups may be spurious: always wait in a loop that re-checks the predicate.
+ * @note A recursive mutex must be held exactly once by the caller. On Linux the call fails if it is held more than once.
+ */
+int pal_cond_wait(pal_cond_t *cond, pal_mutex_t *mutex);
+
+/**
+ * @brief Atomically releases the mutex and waits for the condition variable to be signaled, up to a timeout.
+ *
+ * @param[in] cond Pointer to the condition variable.
+ * @param[in] mutex Pointer to the mutex, locked by the caller. It is locked again before returning.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return 0 on success, or -1 on failure (e.g., timeout).
+ * @note On Linux the timeout is measured on CLOCK_MONOTONIC and is not affected by wall-clock changes.
+ * @note A recursive mutex must be held exactly once by the caller. On Linux the call fails if it is held more than once.
+ */
+int pal_cond_timedwait(pal_cond_t *cond, pal_mutex_t *mutex, size_t timeout_ms);
+
+/**
+ * @brief Wakes up one thread waiting on the condition variable.
+ *
+ * @param[in] cond Pointer to the condition variable.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_cond_signal(pal_cond_t *cond);
+
+/**
+ * @brief Wakes up all threads waiting on the condition variable.
+ *
+ * @param[in] cond Pointer to the condition variable.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_cond_broadcast(pal_cond_t *cond);
+
+/**
+ * @brief Destroys the condition variable.
+ *
+ * @param[in,out] cond Pointer to the condition variable to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ * @note No thread may be waiting on the condition variable.
+ */
+int pal_cond_destroy(pal_cond_t *cond);
+
+#ifdef __cplusplus
+}
+#endif
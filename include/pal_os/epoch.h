@@ -0,0 +1,154 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pal_os/mutex.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifndef PAL_EPOCH_RECLAIM_THRESHOLD
+#define PAL_EPOCH_RECLAIM_THRESHOLD 64	//!< Objects retired by a thread before pal_epoch_retire attempts a reclamation on its own
+#endif
+
+#define PAL_EPOCH_INITIALIZER {0, PAL_MUTEX_INITIALIZER, NULL, NULL}	//!< Static initializer for an epoch domain
+
+// ============================
+// Type Definitions
+// ============================
+typedef struct pal_epoch_node_s pal_epoch_node_t;
+
+/**
+ * @brief Function releasing a retired object.
+ * @param node Node embedded in the object.
+ */
+typedef void (*pal_epoch_free_t)(pal_epoch_node_t *node);
+
+/**
+ * @brief Node embedded in every object that can be retired.
+ */
+struct pal_epoch_node_s
+{
+	pal_epoch_node_t *next;		//!< Next retired object of the same thread
+	pal_epoch_free_t  free_fn;	//!< Function releasing the object
+	uint32_t		  epoch;	//!< Global epoch at retirement
+};
+
+/**
+ * @brief Per-thread state, owned by the thread that registered it.
+ */
+struct pal_epoch_record_s
+{
+	struct pal_epoch_record_s *next;		   //!< Next registered record of the domain
+	struct pal_epoch_s		  *domain;		   //!< Domain the record is registered to
+	uint32_t				   state;		   //!< Epoch observed on entry shifted left by one, bit 0 set inside a read-side section
+	uint32_t				   nesting;		   //!< Depth of nested read-side sections
+	pal_epoch_node_t		  *retired;		   //!< Objects retired by the thread and not yet released, newest first
+	size_t					   retired_count;  //!< Number of objects in the retired list
+};
+typedef struct pal_epoch_record_s pal_epoch_record_t;
+
+struct pal_epoch_s
+{
+	uint32_t			epoch;	   //!< Global epoch
+	pal_mutex_t			lock;	   //!< Protects the records list and serializes epoch advances
+	pal_epoch_record_t *records;   //!< Registered records
+	pal_epoch_node_t   *orphans;   //!< Objects left by unregistered threads and not yet released
+};
+typedef struct pal_epoch_s pal_epoch_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates an epoch-based reclamation domain.
+ *
+ * @param[out] epoch Pointer to the domain to be created.
+ * @return 0 on success, or -1 on failure.
+ * @note A domain defined with PAL_EPOCH_INITIALIZER does not need to be created.
+ */
+int pal_epoch_create(pal_epoch_t *epoch);
+
+/**
+ * @brief Registers the calling thread to the domain.
+ *
+ * @param[in] epoch Pointer to the domain.
+ * @param[out] record Per-thread record. Must stay valid until pal_epoch_unregister returns.
+ * @return 0 on success, or -1 on failure.
+ * @note Every pal_thread_t reading or retiring objects of the domain registers its own record, and only that thread uses it.
+ */
+int pal_epoch_register(pal_epoch_t *epoch, pal_epoch_record_t *record);
+
+/**
+ * @brief Unregisters the thread without waiting for the objects it retired.
+ *
+ * The objects still in their grace period are handed to the domain, which releases them in a later pal_epoch_reclaim of any thread or
+ * in pal_epoch_destroy.
+ *
+ * @param[in,out] record Record passed to pal_epoch_register.
+ * @return 0 on success, or -1 on failure (e.g., called inside a read-side section).
+ */
+int pal_epoch_unregister(pal_epoch_record_t *record);
+
+/**
+ * @brief Enters a read-side section: objects reachable from now on are not released before pal_epoch_exit.
+ *
+ * @param[in] record Record of the calling thread.
+ * @return 0 on success, or -1 on failure.
+ * @note The cost is a store to the record and a memory fence. Sections can be nested.
+ */
+int pal_epoch_enter(pal_epoch_record_t *record);
+
+/**
+ * @brief Leaves a read-side section.
+ *
+ * @param[in] record Record of the calling thread.
+ * @return 0 on success, or -1 on failure (e.g., not inside a read-side section).
+ */
+int pal_epoch_exit(pal_epoch_record_t *record);
+
+/**
+ * @brief Retires an object already unlinked from every shared structure, deferring its release until no reader can access it.
+ *
+ * @param[in] record Record of the calling thread.
+ * @param[in] node Node embedded in the object.
+ * @param[in] free_fn Function releasing the object.
+ * @return 0 on success, or -1 on failure.
+ * @note Every PAL_EPOCH_RECLAIM_THRESHOLD retirements the call also attempts a reclamation, so the cost is amortized over the writers.
+ */
+int pal_epoch_retire(pal_epoch_record_t *record, pal_epoch_node_t *node, pal_epoch_free_t free_fn);
+
+/**
+ * @brief Advances the global epoch if every reader allows it and releases the objects of the thread whose grace period has elapsed.
+ *
+ * The objects handed to the domain by unregistered threads are released too once their grace period has elapsed.
+ *
+ * @param[in] record Record of the calling thread.
+ * @return Number of objects released.
+ * @note Only the objects retired through the record are released, those of other registered threads wait for their own reclaim.
+ * @note A background thread calling it with its own record only advances the epoch and releases the objects of unregistered threads.
+ */
+size_t pal_epoch_reclaim(pal_epoch_record_t *record);
+
+/**
+ * @brief Destroys the domain.
+ *
+ * @param[in,out] epoch Pointer to the domain to be destroyed.
+ * @return 0 on success, or -1 on failure (e.g., threads still registered).
+ * @note The objects left by unregistered threads are released, no reader can access them anymore.
+ */
+int pal_epoch_destroy(pal_epoch_t *epoch);
+
+#ifdef __cplusplus
+}
+#endif
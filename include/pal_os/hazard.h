@@ -0,0 +1,152 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+
+#include "pal_os/mutex.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifndef PAL_HAZARD_SLOTS
+#define PAL_HAZARD_SLOTS 2	//!< Hazard pointers owned by every thread
+#endif
+
+#ifndef PAL_HAZARD_SCAN_THRESHOLD
+#define PAL_HAZARD_SCAN_THRESHOLD 32  //!< Objects retired by a thread before pal_hazard_retire scans the hazard pointers
+#endif
+
+#define PAL_HAZARD_INITIALIZER {PAL_MUTEX_INITIALIZER, NULL}  //!< Static initializer for a hazard pointer domain
+
+// ============================
+// Type Definitions
+// ============================
+typedef struct pal_hazard_node_s pal_hazard_node_t;
+
+/**
+ * @brief Function releasing a retired object.
+ * @param node Node embedded in the object.
+ */
+typedef void (*pal_hazard_free_t)(pal_hazard_node_t *node);
+
+/**
+ * @brief Node embedded in every object that can be retired.
+ */
+struct pal_hazard_node_s
+{
+	pal_hazard_node_t *next;	 //!< Next retired object of the same thread
+	pal_hazard_free_t  free_fn;	 //!< Function releasing the object
+	const void		  *ptr;		 //!< Address of the object, as published to the readers
+};
+
+/**
+ * @brief Per-thread state, owned by the thread that registered it.
+ */
+struct pal_hazard_record_s
+{
+	struct pal_hazard_record_s *next;					   //!< Next registered record of the domain
+	struct pal_hazard_s		   *domain;					   //!< Domain the record is registered to
+	void					   *slots[PAL_HAZARD_SLOTS];  //!< Objects the thread is accessing
+	pal_hazard_node_t		   *retired;				   //!< Objects retired by the thread and not yet released
+	size_t						retired_count;			   //!< Number of objects in the retired list
+	size_t						scan_threshold;			   //!< Retired count at which pal_hazard_retire scans the slots again
+};
+typedef struct pal_hazard_record_s pal_hazard_record_t;
+
+struct pal_hazard_s
+{
+	pal_mutex_t			 lock;	   //!< Protects the records list
+	pal_hazard_record_t *records;  //!< Registered records
+};
+typedef struct pal_hazard_s pal_hazard_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a hazard pointer domain.
+ *
+ * @param[out] hazard Pointer to the domain to be created.
+ * @return 0 on success, or -1 on failure.
+ * @note A domain defined with PAL_HAZARD_INITIALIZER does not need to be created.
+ */
+int pal_hazard_create(pal_hazard_t *hazard);
+
+/**
+ * @brief Registers the calling thread to the domain.
+ *
+ * @param[in] hazard Pointer to the domain.
+ * @param[out] record Per-thread record. Must stay valid until pal_hazard_unregister returns.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_hazard_register(pal_hazard_t *hazard, pal_hazard_record_t *record);
+
+/**
+ * @brief Unregisters the thread, clearing its slots and waiting for every object it retired to be released.
+ *
+ * @param[in,out] record Record passed to pal_hazard_register.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_hazard_unregister(pal_hazard_record_t *record);
+
+/**
+ * @brief Loads a shared pointer and protects the object it points to from being released.
+ *
+ * @param[in] record Record of the calling thread.
+ * @param[in] slot Slot index, lower than PAL_HAZARD_SLOTS. The object previously protected by the slot is no longer protected.
+ * @param[in] src Shared location holding the pointer.
+ * @return The protected pointer, which may be NULL.
+ * @note The location is read again after publishing the hazard, until both reads agree.
+ */
+void *pal_hazard_protect(pal_hazard_record_t *record, size_t slot, void *const *src);
+
+/**
+ * @brief Stops protecting the object held by a slot.
+ *
+ * @param[in] record Record of the calling thread.
+ * @param[in] slot Slot index, lower than PAL_HAZARD_SLOTS.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_hazard_clear(pal_hazard_record_t *record, size_t slot);
+
+/**
+ * @brief Retires an object already unlinked from every shared structure, deferring its release until no slot protects it.
+ *
+ * @param[in] record Record of the calling thread.
+ * @param[in] node Node embedded in the object.
+ * @param[in] ptr Address of the object, as loaded by pal_hazard_protect.
+ * @param[in] free_fn Function releasing the object.
+ * @return 0 on success, or -1 on failure.
+ * @note Retired objects are batched: the slots are scanned once PAL_HAZARD_SCAN_THRESHOLD more are pending than after the last scan,
+ * so a thread never holds more than PAL_HAZARD_SCAN_THRESHOLD objects plus the ones protected by the other threads.
+ */
+int pal_hazard_retire(pal_hazard_record_t *record, pal_hazard_node_t *node, const void *ptr, pal_hazard_free_t free_fn);
+
+/**
+ * @brief Releases the retired objects of the thread that no slot protects.
+ *
+ * @param[in] record Record of the calling thread.
+ * @return Number of objects released.
+ * @note The objects are released once the domain lock is dropped, so their free functions may use the domain.
+ */
+size_t pal_hazard_scan(pal_hazard_record_t *record);
+
+/**
+ * @brief Destroys the domain.
+ *
+ * @param[in,out] hazard Pointer to the domain to be destroyed.
+ * @return 0 on success, or -1 on failure (e.g., threads still registered).
+ */
+int pal_hazard_destroy(pal_hazard_t *hazard);
+
+#ifdef __cplusplus
+}
+#endif
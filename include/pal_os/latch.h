@@ -0,0 +1,87 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#include <stdint.h>
+#ifdef PAL_OS_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#endif
+#include "pal_os/common.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifdef PAL_OS_LINUX
+#define PAL_LATCH_INITIALIZER(count) {(count)}	//!< Static initializer for a latch
+#elif defined PAL_OS_FREERTOS
+#define PAL_LATCH_INITIALIZER(count) {NULL, (count)}  //!< Static initializer for a latch, the event group is created on first use
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+#ifdef PAL_OS_LINUX
+struct pal_latch_s
+{
+	uint32_t count;	 //!< Futex word holding the number of pending count downs
+};
+#elif defined PAL_OS_FREERTOS
+struct pal_latch_s
+{
+	EventGroupHandle_t group;  //!< Event group the waiters block on, a bit is set when the count reaches 0
+	uint32_t		   count;  //!< Number of pending count downs
+};
+#endif
+typedef struct pal_latch_s pal_latch_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a countdown latch.
+ *
+ * @param[out] latch Pointer to the latch to be created.
+ * @param[in] count Number of count downs needed to release the waiters.
+ * @return 0 on success, or -1 on failure.
+ * @note A latch defined with PAL_LATCH_INITIALIZER does not need to be created.
+ */
+int pal_latch_create(pal_latch_t *latch, size_t count);
+
+/**
+ * @brief Decrements the latch count, releasing every waiter when it reaches 0.
+ *
+ * @param[in] latch Pointer to the latch.
+ * @return 0 on success, or -1 on failure (e.g., the count is already 0).
+ */
+int pal_latch_count_down(pal_latch_t *latch);
+
+/**
+ * @brief Waits for the latch count to reach 0.
+ *
+ * @param[in] latch Pointer to the latch.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for no wait, or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return 0 on success, or -1 on failure (e.g., timeout).
+ * @note Once released the latch stays open: it cannot be reset.
+ */
+int pal_latch_wait(pal_latch_t *latch, size_t timeout_ms);
+
+/**
+ * @brief Destroys the latch.
+ *
+ * @param[in,out] latch Pointer to the latch to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_latch_destroy(pal_latch_t *latch);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+
+#include "pal_os/common.h"
+#include "pal_os/mutex.h"
+
+// ============================
+// Macros and Constants
+// ============================
+
+// ============================
+// Type Definitions
+// ============================
+/**
+ * @brief One lock of a stripe, padded to a full cache line so that neighbouring locks never share one.
+ */
+struct pal_lock_stripe_slot_s
+{
+	pal_mutex_t mutex;	//!< Lock protecting the keys mapped to this slot
+} __attribute__((aligned(PAL_OS_CACHE_LINE_SIZE)));
+typedef struct pal_lock_stripe_slot_s pal_lock_stripe_slot_t;
+
+struct pal_lock_stripe_s
+{
+	pal_lock_stripe_slot_t *slots;	//!< Caller provided array of locks
+	size_t					count;	//!< Number of locks in the array
+};
+typedef struct pal_lock_stripe_s pal_lock_stripe_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a lock stripe on caller provided storage.
+ *
+ * @param[out] stripe Pointer to the lock stripe to be created.
+ * @param[in] slots Array of count slots. Must stay valid until the stripe is destroyed.
+ * @param[in] count Number of slots. Cannot be 0.
+ * @return 0 on success, or -1 on failure.
+ * @note Declare the slots as an array (static, global or on the stack) to get the cache line alignment: heap blocks are usually less aligned.
+ */
+int pal_lock_stripe_create(pal_lock_stripe_t *stripe, pal_lock_stripe_slot_t *slots, size_t count);
+
+/**
+ * @brief Gets the index of the slot protecting a key.
+ *
+ * @param[in] stripe Pointer to the lock stripe.
+ * @param[in] key Key, e.g. a hash table bucket index or an object address.
+ * @return Slot index, always lower than the number of slots.
+ * @note Keys are mixed before being mapped, so sequential keys and aligned addresses spread evenly over the slots.
+ */
+size_t pal_lock_stripe_index(const pal_lock_stripe_t *stripe, size_t key);
+
+/**
+ * @brief Locks the slot protecting a key.
+ *
+ * @param[in] stripe Pointer to the lock stripe.
+ * @param[in] key Key to lock.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for no wait, or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return 0 on success, or -1 on failure (e.g., timeout).
+ * @note Different keys may share a slot: a thread must not lock a second key while holding one, use pal_lock_stripe_lock_all instead.
+ */
+int pal_lock_stripe_lock_key(pal_lock_stripe_t *stripe, size_t key, size_t timeout_ms);
+
+/**
+ * @brief Unlocks the slot protecting a key.
+ *
+ * @param[in] stripe Pointer to the lock stripe.
+ * @param[in] key Key passed to pal_lock_stripe_lock_key.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_lock_stripe_unlock_key(pal_lock_stripe_t *stripe, size_t key);
+
+/**
+ * @brief Locks every slot, e.g. to resize the protected table.
+ *
+ * @param[in] stripe Pointer to the lock stripe.
+ * @return 0 on success, or -1 on failure.
+ * @note Slots are always taken in ascending order, so concurrent callers cannot deadlock with each other.
+ */
+int pal_lock_stripe_lock_all(pal_lock_stripe_t *stripe);
+
+/**
+ * @brief Unlocks every slot locked by pal_lock_stripe_lock_all.
+ *
+ * @param[in] stripe Pointer to the lock stripe.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_lock_stripe_unlock_all(pal_lock_stripe_t *stripe);
+
+/**
+ * @brief Destroys the lock stripe.
+ *
+ * @param[in,out] stripe Pointer to the lock stripe to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_lock_stripe_destroy(pal_lock_stripe_t *stripe);
+
+#ifdef __cplusplus
+}
+#endif
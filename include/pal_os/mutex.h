@@ -10,7 +10,7 @@ extern "C"
 // ============================
 #include <stddef.h>
 #ifdef PAL_OS_LINUX
-#include <pthread.h>
+#include <stdint.h>
 
 #include "stdbool.h"
 #elif defined PAL_OS_FREERTOS
@@ -21,6 +21,13 @@ extern "C"
 // ============================
 // Macros and Constants
 // ============================
+#ifdef PAL_OS_LINUX
+#define PAL_MUTEX_INITIALIZER			{0, 0, false, true}	//!< Static initializer for a non-recursive mutex
+#define PAL_RECURSIVE_MUTEX_INITIALIZER {0, 0, true, true}	//!< Static initializer for a recursive mutex
+#elif defined PAL_OS_FREERTOS
+#define PAL_MUTEX_INITIALIZER			{NULL, 0}  //!< Static initializer for a non-recursive mutex
+#define PAL_RECURSIVE_MUTEX_INITIALIZER {NULL, 1}  //!< Static initializer for a recursive mutex
+#endif
 
 // ============================
 // Type Definitions
@@ -28,13 +35,15 @@ extern "C"
 #ifdef PAL_OS_LINUX
 struct pal_mutex_s
 {
-	pthread_mutex_t mutex;	  //!< Mutex for thread safety
-	bool			created;  //!< Flag indicating if the mutex has been created
+	uint32_t state;		 //!< Futex word: 0 unlocked, 1 locked, 2 locked with waiters. Owner thread id and waiters flag for recursive mutexes
+	uint32_t depth;		 //!< Number of nested locks held by the owner beyond the first one, only accessed by the owner
+	bool	 recursive;	 //!< Flag indicating if the mutex is recursive
+	bool	 created;	 //!< Flag indicating if the mutex has been created
 };
 #elif defined PAL_OS_FREERTOS
 struct pal_mutex_s
 {
-	SemaphoreHandle_t mutex_handle;	 //!< Mutex handle
+	SemaphoreHandle_t mutex_handle;	 //!< Mutex handle, created on first use when statically initialized
 	int				  is_recursive;	 //!< Flag indicating if the mutex is recursive
 };
 #endif
@@ -50,6 +59,7 @@ typedef struct pal_mutex_s pal_mutex_t;
  * @param[out] mutex Pointer to the mutex handle to be created.
  * @param[in] recursive Indicates whether the mutex should be recursive (non-zero for recursive).
  * @return 0 on success, or -1 on failure.
+ * @note A mutex defined with PAL_MUTEX_INITIALIZER or PAL_RECURSIVE_MUTEX_INITIALIZER does not need to be created.
  */
 int pal_mutex_create(pal_mutex_t *mutex, int recursive);
 
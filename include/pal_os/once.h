@@ -0,0 +1,66 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stdint.h>
+#ifdef PAL_OS_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#endif
+
+// ============================
+// Macros and Constants
+// ============================
+#ifdef PAL_OS_LINUX
+#define PAL_ONCE_INIT {0}  //!< Static initializer for a once control
+#elif defined PAL_OS_FREERTOS
+#define PAL_ONCE_INIT {0, NULL}	 //!< Static initializer for a once control, the event group is created only if a task has to wait
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+#ifdef PAL_OS_LINUX
+struct pal_once_s
+{
+	uint32_t state;	 //!< Futex word holding the initialization state
+};
+#elif defined PAL_OS_FREERTOS
+struct pal_once_s
+{
+	uint32_t		   state;  //!< Initialization state
+	EventGroupHandle_t group;  //!< Event group the waiters block on while the initialization runs
+};
+#endif
+typedef struct pal_once_s pal_once_t;
+
+/**
+ * @brief Initialization function run by pal_once_call.
+ */
+typedef void (*pal_once_func_t)(void *arg);
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Runs func exactly once for the given control, even if called concurrently.
+ *
+ * @param[in] once Pointer to a control defined with PAL_ONCE_INIT.
+ * @param[in] func Initialization function.
+ * @param[in] arg Argument passed to func.
+ * @return 0 once func has completed, or -1 on failure.
+ * @note Callers arriving while func runs block until it returns. After completion the call is a single atomic load.
+ * @note func must not call pal_once_call on the same control.
+ */
+int pal_once_call(pal_once_t *once, pal_once_func_t func, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
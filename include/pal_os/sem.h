@@ -0,0 +1,110 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <stddef.h>
+#ifdef PAL_OS_LINUX
+#include <stdint.h>
+#elif defined PAL_OS_FREERTOS
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
+#include "pal_os/common.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#ifdef PAL_OS_LINUX
+#define PAL_SEM_INITIALIZER(max_count, initial_count) {(initial_count), 0, (max_count)}	 //!< Static initializer for a counting semaphore
+#elif defined PAL_OS_FREERTOS
+#define PAL_SEM_INITIALIZER(max_count, initial_count) \
+	{NULL, (max_count), (initial_count)}  //!< Static initializer for a counting semaphore, the semaphore is created on first use
+#endif
+
+// ============================
+// Type Definitions
+// ============================
+#ifdef PAL_OS_LINUX
+struct pal_sem_s
+{
+	uint32_t count;		 //!< Futex word holding the number of available units
+	uint32_t waiters;	 //!< Number of threads blocked in pal_sem_take
+	uint32_t max_count;	 //!< Maximum number of available units
+};
+#elif defined PAL_OS_FREERTOS
+struct pal_sem_s
+{
+	SemaphoreHandle_t handle;		  //!< Counting semaphore handle
+	UBaseType_t		  max_count;	  //!< Maximum count, used when the semaphore is created on first use
+	UBaseType_t		  initial_count;  //!< Initial count, used when the semaphore is created on first use
+};
+#endif
+typedef struct pal_sem_s pal_sem_t;
+
+// ============================
+// Function Declarations
+// ============================
+
+/**
+ * @brief Creates a counting semaphore.
+ *
+ * @param[out] sem Pointer to the semaphore to be created.
+ * @param[in] max_count Maximum count. Cannot be 0.
+ * @param[in] initial_count Initial count. Cannot be greater than max_count.
+ * @return 0 on success, or -1 on failure.
+ * @note A semaphore defined with PAL_SEM_INITIALIZER does not need to be created.
+ */
+int pal_sem_create(pal_sem_t *sem, size_t max_count, size_t initial_count);
+
+/**
+ * @brief Takes one unit from the semaphore.
+ *
+ * @param[in] sem Pointer to the semaphore.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for no wait, or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return 0 on success, or -1 on failure (e.g., timeout).
+ * @note On Linux an available unit is taken with a single atomic operation, the kernel is entered only to block.
+ */
+int pal_sem_take(pal_sem_t *sem, size_t timeout_ms);
+
+/**
+ * @brief Gives one unit back to the semaphore.
+ *
+ * @param[in] sem Pointer to the semaphore.
+ * @return 0 on success, or -1 on failure (e.g., the count is already at its maximum).
+ */
+int pal_sem_give(pal_sem_t *sem);
+
+/**
+ * @brief Gives one unit back to the semaphore from ISR.
+ *
+ * @param[in] sem Pointer to the semaphore.
+ * @return 0 on success, or -1 on failure (e.g., the count is already at its maximum).
+ */
+int pal_sem_give_from_isr(pal_sem_t *sem);
+
+/**
+ * @brief Gets the number of available units.
+ *
+ * @param[in] sem Pointer to the semaphore.
+ * @return Number of available units.
+ * @note Will return 0 if the semaphore is NULL.
+ */
+size_t pal_sem_get_count(pal_sem_t *sem);
+
+/**
+ * @brief Destroys the semaphore.
+ *
+ * @param[in,out] sem Pointer to the semaphore to be destroyed.
+ * @return 0 on success, or -1 on failure.
+ */
+int pal_sem_destroy(pal_sem_t *sem);
+
+#ifdef __cplusplus
+}
+#endif
@@ -11,24 +11,64 @@ extern "C"
 #include <stddef.h>
 #ifdef PAL_OS_LINUX
 #include <pthread.h>
-#include <semaphore.h>
+#include <stdint.h>
 #endif
 #include "pal_os/common.h"
 
 // ============================
 // Macros and Constants
 // ============================
+#ifdef PAL_OS_LINUX
+#define PAL_SIGNAL_INITIALIZER {PTHREAD_MUTEX_INITIALIZER, NULL, 0, NULL}	 //!< Static initializer for a signal object
+#elif defined PAL_OS_FREERTOS
+#define PAL_SIGNAL_INITIALIZER NULL	 //!< Static initializer for a signal object, the event group is created on first use
+#endif
+
+#ifndef PAL_SIGNAL_LATENCY_BUCKETS
+#define PAL_SIGNAL_LATENCY_BUCKETS 24  //!< Buckets of the wake latency histogram, the last one collects every longer latency
+#endif
 
 // ============================
 // Type Definitions
 // ============================
 
+/**
+ * @brief Statistics of a signal object, collected once enabled with pal_signal_enable_stats.
+ */
+typedef struct pal_signal_stats_s
+{
+	size_t sets;												//!< Calls to pal_signal_set and pal_signal_set_from_isr
+	size_t clears;												//!< Calls to pal_signal_clear
+	size_t waits;												//!< Waits not satisfied on entry, that registered as waiters
+	size_t waiters;												//!< Threads currently registered as waiters
+	size_t timeouts;											//!< Registered waits that timed out
+	size_t spurious_wakeups;									//!< Wakeups that found the wait still unsatisfied
+	size_t wake_latency_us[PAL_SIGNAL_LATENCY_BUCKETS];	//!< Time from the satisfying set to the waiter return: bucket 0 counts
+																//!< latencies below 1 us, bucket i latencies in [2^(i-1), 2^i) us
+} pal_signal_stats_t;
+
 #ifdef PAL_OS_LINUX
+/**
+ * @brief Thread blocked in pal_signal_wait, linked in the signal object while it waits.
+ */
+struct pal_signal_waiter_s
+{
+	struct pal_signal_waiter_s *next;		//!< Next waiter of the same signal object
+	size_t						mask;		//!< Bitmask of signals the thread waits for
+	int							wait_all;	//!< Non-zero if every signal in mask is needed
+	int							clear;		//!< Non-zero if the received signals are cleared on wakeup
+	size_t						received;	//!< Signals received, written by the thread that satisfied the wait
+	uint32_t				   *state;		//!< Futex word the thread sleeps on, shared by every waiter of a pal_signal_wait_multi call
+	uint32_t					index;		//!< Value stored in state, minus one, by the thread that claims this waiter
+	uint64_t					claimed_ns;	//!< CLOCK_MONOTONIC time of the claim, recorded only when statistics are enabled
+};
+
 struct pal_signal_s
 {
-	pthread_mutex_t mutex;	  //!< Mutex for thread safety.
-	pthread_cond_t	cond;	  //!< Condition variable for signaling.
-	size_t			signals;  //!< Bitmask of active signals.
+	pthread_mutex_t				mutex;	   //!< Mutex for thread safety.
+	struct pal_signal_waiter_s *waiters;   //!< Threads blocked in pal_signal_wait.
+	size_t						signals;   //!< Bitmask of active signals, updated atomically.
+	pal_signal_stats_t		   *stats;	   //!< Statistics, or NULL when not collected.
 };
 typedef struct pal_signal_s pal_signal_t;
 
@@ -37,6 +77,21 @@ typedef void *pal_signal_t;
 
 #endif
 
+/**
+ * @brief Condition of a pal_signal_wait_multi call.
+ */
+typedef struct pal_signal_wait_entry_s
+{
+	pal_signal_t *signal;			 //!< Signal object to wait on
+	size_t		  mask;				 //!< Bitmask of signals to wait for
+	int			  wait_all;			 //!< If 1, wait for all specified signals; if 0, wait for any
+	int			  clear_mask;		 //!< If 1, clear received signals when this entry satisfies the wait
+	size_t		  received_signals;	 //!< Signals received, written only for the entry that satisfied the wait
+#ifdef PAL_OS_LINUX
+	struct pal_signal_waiter_s waiter;	//!< Waiter linked in the signal object, private to the implementation
+#endif
+} pal_signal_wait_entry_t;
+
 /**
  * @brief Return codes for signal wait operation.
  */
@@ -56,6 +111,7 @@ typedef enum pal_signal_ret_code_e
  *
  * @param[out] signal Pointer to the signal object to initialize.
  * @return 0 on success, or -1 on failure.
+ * @note A signal object defined with PAL_SIGNAL_INITIALIZER does not need to be created.
  */
 int pal_signal_create(pal_signal_t *signal);
 
@@ -69,16 +125,48 @@ int pal_signal_create(pal_signal_t *signal);
  * @param[in] wait_all If 1, wait for all specified signals; if 0, wait for any.
  * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for non-blocking or PAL_OS_INFINITE_TIMEOUT for infinite wait.
  * @return PAL_SIGNAL_SUCCESS if signals are received within the timeout, PAL_SIGNAL_TIMEOUT if timeout occurs, or PAL_SIGNAL_FAILURE on error.
- * @note This function blocks until the specified signals are set or the timeout occurs.
+ * @note This function blocks until the specified signals are set or the timeout occurs. On Linux every waiter sleeps on its own word
+ * and is woken only by the pal_signal_set that satisfies its mask. A wait already satisfied, or with PAL_OS_NO_TIMEOUT, never takes
+ * the mutex.
  */
 pal_signal_ret_code_t pal_signal_wait(pal_signal_t *signal, size_t mask, size_t *received_signals, int clear_mask, int wait_all, size_t timeout_ms);
 
+/**
+ * @brief Waits until the condition of any of several signal objects is met.
+ *
+ * @param[in,out] entries Conditions to wait for. The received signals are stored in the entry that satisfied the wait.
+ * @param[in] count Number of entries. Cannot be 0.
+ * @param[out] index Index of the entry that satisfied the wait. When several are met, the first one is reported.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for non-blocking or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return PAL_SIGNAL_SUCCESS if an entry was satisfied within the timeout, PAL_SIGNAL_TIMEOUT if timeout occurs, or PAL_SIGNAL_FAILURE
+ * on error.
+ * @note Only the satisfying entry has its signals cleared. On Linux the thread is linked in every signal object through a shared
+ * futex word and sleeps until one pal_signal_set claims it. On freeRTOS, where a task cannot block on several event groups, the task
+ * blocks on its own semaphore, given by every pal_signal_set of one of the signals, and checks the entries again when woken.
+ */
+pal_signal_ret_code_t pal_signal_wait_multi(pal_signal_wait_entry_t *entries, size_t count, size_t *index, size_t timeout_ms);
+
+/**
+ * @brief Sets signals and waits for a set of signals to be all set, as a single rendezvous operation.
+ *
+ * @param[in] signal Signal object to synchronize on.
+ * @param[in] set_mask Bitmask of signals to set, usually the bit of the calling thread.
+ * @param[in] wait_mask Bitmask of signals that must all be set. Cannot be 0.
+ * @param[in] timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for non-blocking or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return PAL_SIGNAL_SUCCESS if every signal in wait_mask was set within the timeout, PAL_SIGNAL_TIMEOUT if timeout occurs, or
+ * PAL_SIGNAL_FAILURE on error.
+ * @note The signals of wait_mask are cleared when the rendezvous completes, so the same object can be reused for the next cycle.
+ * On freeRTOS this maps to xEventGroupSync.
+ */
+pal_signal_ret_code_t pal_signal_sync(pal_signal_t *signal, size_t set_mask, size_t wait_mask, size_t timeout_ms);
+
 /**
  * @brief Sets one or more signals.
  *
  * @param[in] signal Signal object to modify.
  * @param[in] mask Bitmask of signals to set.
  * @return 0 on success, or -1 on failure.
+ * @note On Linux the signals are set with a single atomic operation, the mutex and the kernel are entered only if a thread waits.
  */
 int pal_signal_set(pal_signal_t *signal, size_t mask);
 
@@ -89,7 +177,7 @@ int pal_signal_set(pal_signal_t *signal, size_t mask);
  * @param[in] mask Bitmask of signals to set.
  * @return 0 on success, or -1 on failure.
  */
-int pal_signal_set(pal_signal_t *signal, size_t mask);
+int pal_signal_set_from_isr(pal_signal_t *signal, size_t mask);
 
 /**
  * @brief Clears one or more signals.
@@ -97,9 +185,31 @@ int pal_signal_set(pal_signal_t *signal, size_t mask);
  * @param[in] signal Signal object to modify.
  * @param[in] mask Bitmask of signals to clear.
  * @return 0 on success, or -1 on failure.
+ * @note On Linux the signals are cleared with a single atomic operation.
  */
 int pal_signal_clear(pal_signal_t *signal, size_t mask);
 
+/**
+ * @brief Starts collecting statistics for a signal object.
+ *
+ * @param[in] signal Signal object to instrument.
+ * @param[out] stats Storage for the statistics, reset by this call. Must stay valid while the signal is in use. NULL stops the collection.
+ * @return 0 on success, or -1 on failure (e.g., not supported by the platform).
+ * @note Must be called before the signal object is shared with other threads. Not supported on freeRTOS, where waiters are woken by
+ * the kernel event group.
+ */
+int pal_signal_enable_stats(pal_signal_t *signal, pal_signal_stats_t *stats);
+
+/**
+ * @brief Takes a snapshot of the statistics of a signal object.
+ *
+ * @param[in] signal Signal object with statistics enabled.
+ * @param[out] stats Pointer to store the snapshot.
+ * @return 0 on success, or -1 on failure (e.g., statistics not enabled).
+ * @note Each counter is read atomically, but counters updated concurrently may be slightly inconsistent with one another.
+ */
+int pal_signal_get_stats(pal_signal_t *signal, pal_signal_stats_t *stats);
+
 /**
  * @brief Destroys a signal object and releases associated resources.
  *
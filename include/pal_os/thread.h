@@ -9,6 +9,7 @@ extern "C"
 // Includes
 // ============================
 #include <stddef.h>
+#include <stdint.h>
 #ifdef PAL_OS_LINUX
 #include <pthread.h>
 #elif defined PAL_OS_FREERTOS
@@ -48,16 +49,28 @@ typedef enum pal_thread_state_e
 	PAL_THREAD_STATE_TERMINATED,  //!< Thread is terminated
 } pal_thread_state_t;
 
+/**
+ * @brief Action applied to the notification value of the target thread.
+ */
+typedef enum pal_thread_notify_action_e
+{
+	PAL_THREAD_NOTIFY_SET_BITS,	  //!< Bitwise OR the value into the notification value
+	PAL_THREAD_NOTIFY_INCREMENT,  //!< Increment the notification value by one, the value is ignored
+	PAL_THREAD_NOTIFY_OVERWRITE,  //!< Overwrite the notification value
+} pal_thread_notify_action_t;
+
 #ifdef PAL_OS_LINUX
 struct pal_thread_s
 {
-	pthread_t			  thread;	   // POSIX thread identifier
-	pal_thread_func_t	  func;		   // Function to be executed by the thread
-	void				 *arg;		   // Argument to be passed to the thread function
-	pal_thread_state_t	  state;	   // State of the thread
-	size_t				  stack_size;  // Size of the thread stack
-	pal_thread_priority_t priority;	   // Thread priority
-	const char			 *name;		   // Thread name
+	pthread_t			  thread;		 // POSIX thread identifier
+	pal_thread_func_t	  func;			 // Function to be executed by the thread
+	void				 *arg;			 // Argument to be passed to the thread function
+	pal_thread_state_t	  state;		 // State of the thread
+	size_t				  stack_size;	 // Size of the thread stack
+	pal_thread_priority_t priority;		 // Thread priority
+	const char			 *name;			 // Thread name
+	uint32_t			  notify_value;	 // Notification value
+	uint32_t			  notify_state;	 // Futex word: no notification, notification pending or thread waiting
 };
 #elif defined PAL_OS_FREERTOS
 struct pal_thread_s
@@ -126,6 +139,39 @@ const char *pal_thread_get_name(pal_thread_t *const thread);
  */
 size_t pal_thread_get_stack_watermark(pal_thread_t *const thread);
 
+/**
+ * @brief Send a direct notification to a thread.
+ *
+ * @param thread Pointer to the thread to notify.
+ * @param value Value combined with the notification value of the thread according to action.
+ * @param action Action applied to the notification value.
+ * @return 0 on success, -1 on failure.
+ * @note This is considerably cheaper than a signal or a queue to wake up a single worker.
+ */
+int pal_thread_notify(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action);
+
+/**
+ * @brief Send a direct notification to a thread from ISR.
+ *
+ * @param thread Pointer to the thread to notify.
+ * @param value Value combined with the notification value of the thread according to action.
+ * @param action Action applied to the notification value.
+ * @return 0 on success, -1 on failure.
+ */
+int pal_thread_notify_from_isr(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action);
+
+/**
+ * @brief Wait for a direct notification to the calling thread.
+ *
+ * @param clear_on_entry Bits cleared from the notification value on entry, if no notification is already pending.
+ * @param clear_on_exit Bits cleared from the notification value before returning, if a notification was received.
+ * @param[out] value Pointer to store the notification value before the exit bits are cleared. Can be NULL.
+ * @param timeout_ms Timeout in milliseconds. Use PAL_OS_NO_TIMEOUT for non-blocking or PAL_OS_INFINITE_TIMEOUT for infinite wait.
+ * @return 0 if a notification was received, -1 on timeout or failure.
+ * @note The calling thread must have been created with pal_thread_create.
+ */
+int pal_thread_notify_wait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, size_t timeout_ms);
+
 /**
  * @brief Free the thread structure.
  * @note The thread should be joined before calling this function.
@@ -11,27 +11,92 @@ extern "C"
 #include <stddef.h>
 #ifdef PAL_OS_LINUX
 #include <pthread.h>
+#include <stdint.h>
 #include <time.h>
 
 #endif
+#include "pal_os/queue.h"
 // ============================
 // Macros and Constants
 // ============================
+#ifndef PAL_TIMER_WHEEL_TICK_MS
+#define PAL_TIMER_WHEEL_TICK_MS 10	//!< Granularity of the timing wheel on Linux: wheel timers fire up to one tick late
+#endif
+
+#ifndef PAL_TIMER_POOL_WORKERS
+#define PAL_TIMER_POOL_WORKERS 2  //!< Worker threads running the callbacks of timers dispatched to the pool on Linux
+#endif
+
+#ifndef PAL_TIMER_WHEEL_SLOTS
+#define PAL_TIMER_WHEEL_SLOTS 512  //!< Slots of the timing wheel on Linux, timers due PAL_TIMER_WHEEL_SLOTS ticks apart share a slot
+#endif
+
+#ifndef PAL_TIMER_MAX_SHARDS
+#define PAL_TIMER_MAX_SHARDS 8	//!< Timer service shards on Linux, each with its own thread, timer structures and lock
+#endif
 
 // ============================
 // Type Definitions
 // ============================
 
+/**
+ * @brief Structure used by the timer service to schedule a timer
+ */
+typedef enum pal_timer_backend_e
+{
+	PAL_TIMER_BACKEND_HEAP,	  //!< Binary heap: exact deadlines, O(log n) start and stop
+	PAL_TIMER_BACKEND_WHEEL,  //!< Hashed timing wheel: deadlines rounded up to PAL_TIMER_WHEEL_TICK_MS, O(1) start and stop
+} pal_timer_backend_t;
+
+/**
+ * @brief Handling of the periods a periodic timer missed because its callback or the timer service ran late
+ */
+typedef enum pal_timer_overrun_policy_e
+{
+	PAL_TIMER_OVERRUN_SKIP,		 //!< Run the callback once and drop the missed periods, keeping the original phase
+	PAL_TIMER_OVERRUN_CATCH_UP,	 //!< Run the callback back to back once for every missed period
+	PAL_TIMER_OVERRUN_COALESCE,	 //!< Run the callback once and restart the period from now
+} pal_timer_overrun_policy_t;
+
+/**
+ * @brief Context running the callback of an expired timer
+ */
+typedef enum pal_timer_dispatch_e
+{
+	PAL_TIMER_DISPATCH_SERVICE,	 //!< The timer service thread, delaying every later timer while the callback runs
+	PAL_TIMER_DISPATCH_POOL,	 //!< A worker of the timer pool
+	PAL_TIMER_DISPATCH_QUEUE,	 //!< The thread draining a queue the expired timer is posted to, which calls pal_timer_run_dispatched
+} pal_timer_dispatch_t;
+
 #ifdef PAL_OS_LINUX
 struct pal_timer_s
 {
-	struct timespec expiry_time;			 //!< Expiry time of the timer
-	void (*callback)(struct pal_timer_s *);	 //!< Callback function to be called when the timer expires
-	void			   *arg;				 //!< User-defined argument passed to the callback function
-	int					is_periodic;		 //!< Flag indicating if the timer is periodic
-	int					is_started;			 //!< Flag indicating if the timer is started
-	size_t				period_ms;			 //!< Timer period in milliseconds
-	struct pal_timer_s *next;				 //!< Pointer to the next timer in the list
+	struct timespec			   expiry_time;			 //!< Expiry time of the timer
+	void (*callback)(struct pal_timer_s *);			 //!< Callback function to be called when the timer expires
+	void					  *arg;					 //!< User-defined argument passed to the callback function
+	int						   is_periodic;			 //!< Flag indicating if the timer is periodic
+	int						   is_started;			 //!< Flag indicating if the timer is started
+	size_t					   period_us;			 //!< Timer period in microseconds
+	size_t					   heap_index;			 //!< Position of the timer in the timer heap, valid while the timer is started
+	size_t					   slack_ms;			 //!< Lateness the timer tolerates, letting its expiry share a wakeup with other timers
+	size_t					   spin_us;				 //!< Time before the expiry the service wakes up at to busy-wait for the deadline
+	struct timespec			   latest_time;			 //!< Expiry time plus slack, the key of the timer heap
+	pal_timer_backend_t		   backend;				 //!< Structure scheduling the timer
+	pal_timer_overrun_policy_t overrun_policy;		 //!< Handling of missed periods
+	size_t					   overruns;			 //!< Periods missed since the timer was started
+	int						   queue;				 //!< Structure currently holding the timer
+	uint64_t				   wheel_tick;			 //!< Wheel tick the timer is due at
+	struct pal_timer_s		  *prev;				 //!< Previous timer in the same wheel slot or expired list
+	struct pal_timer_s		  *next;				 //!< Next timer in the same wheel slot or expired list
+	pal_timer_dispatch_t	   dispatch;			 //!< Context running the callback
+	int						   concurrent;			 //!< Flag indicating if dispatched runs of the callback may overlap
+	pal_queue_t				  *dispatch_queue;		 //!< Queue the expired timer is posted to
+	size_t					   dispatch_pending;	 //!< Dispatched expirations whose callback has not started yet
+	size_t					   dispatch_running;	 //!< Dispatched callback runs in progress
+	int						   dispatch_queued;		 //!< Flag indicating if the timer waits for a pool worker or in its queue
+	struct pal_timer_s		  *dispatch_next;		 //!< Next timer waiting for a pool worker
+	size_t					   shard;				 //!< Timer service shard scheduling the timer
+	int						   shard_set;			 //!< Flag indicating if the timer was assigned to its shard
 };
 typedef struct pal_timer_s pal_timer_t;
 
@@ -64,7 +129,7 @@ typedef void (*pal_timer_callback_t)(pal_timer_t *arg);
  * @param[in] name Name of the timer. This is used for debugging purposes.
  * @note Not available in linux.
  * @param[in] type Type of the timer (one-shot or periodic).
- * @param[in] period Timer period in milliseconds. Cannot be 0.
+ * @param[in] period Timer period in milliseconds. Cannot be 0. On Linux, cannot exceed SIZE_MAX / 1000.
  * @param[in] callback Function to be called when the timer expires.
  * @param[in] auto_start If non-zero, the timer starts automatically after creation.
  * @param[in] arg User-defined argument passed to the callback function.
@@ -72,6 +137,22 @@ typedef void (*pal_timer_callback_t)(pal_timer_t *arg);
  */
 int pal_timer_create(pal_timer_t *timer, const char *name, pal_timer_type_t type, size_t period, pal_timer_callback_t callback, int auto_start, void *arg);
 
+/**
+ * @brief Creates a new timer with a period in microseconds.
+ *
+ * @param[out] timer Pointer to the timer handle to be created.
+ * @param[in] name Name of the timer. This is used for debugging purposes.
+ * @note Not available in linux.
+ * @param[in] type Type of the timer (one-shot or periodic).
+ * @param[in] period_us Timer period in microseconds. Cannot be 0.
+ * @param[in] callback Function to be called when the timer expires.
+ * @param[in] auto_start If non-zero, the timer starts automatically after creation.
+ * @param[in] arg User-defined argument passed to the callback function.
+ * @return 0 on success, or -1 on failure.
+ * @note On freeRTOS the period is rounded to the nearest tick, at least one, see pal_timer_get_resolution_us.
+ */
+int pal_timer_create_us(pal_timer_t *timer, const char *name, pal_timer_type_t type, size_t period_us, pal_timer_callback_t callback, int auto_start, void *arg);
+
 /**
  * @brief Starts a stopped timer.
  *
@@ -124,7 +205,7 @@ int pal_timer_restart_from_isr(pal_timer_t *timer);
  * @brief Changes the period of a timer.
  *
  * @param[in] timer Pointer to the timer handle.
- * @param[in] new_period New timer period in milliseconds. Cannot be 0.
+ * @param[in] new_period New timer period in milliseconds. Cannot be 0. On Linux, cannot exceed SIZE_MAX / 1000.
  * @return 0 on success, or -1 on failure.
  */
 int pal_timer_change_period(pal_timer_t *timer, size_t new_period);
@@ -138,6 +219,128 @@ int pal_timer_change_period(pal_timer_t *timer, size_t new_period);
  */
 int pal_timer_change_period_from_isr(pal_timer_t *timer, size_t new_period);
 
+/**
+ * @brief Changes the period of a timer to a value in microseconds.
+ *
+ * @param[in] timer Pointer to the timer handle.
+ * @param[in] new_period_us New timer period in microseconds. Cannot be 0.
+ * @return 0 on success, or -1 on failure.
+ * @note On freeRTOS the period is rounded to the nearest tick, at least one, see pal_timer_get_resolution_us.
+ */
+int pal_timer_change_period_us(pal_timer_t *timer, size_t new_period_us);
+
+/**
+ * @brief Gets the granularity timer periods and expiries are kept at.
+ *
+ * @return Resolution in microseconds: the monotonic clock resolution on Linux, the tick period on freeRTOS.
+ */
+size_t pal_timer_get_resolution_us(void);
+
+/**
+ * @brief Selects the structure scheduling a timer.
+ *
+ * @param[in] timer Pointer to the timer handle. Must not be active.
+ * @param[in] backend PAL_TIMER_BACKEND_HEAP (default) for exact deadlines, or PAL_TIMER_BACKEND_WHEEL for very large numbers of timers
+ * that tolerate PAL_TIMER_WHEEL_TICK_MS of lateness.
+ * @return 0 on success, or -1 on failure (e.g., the timer is active).
+ * @note On freeRTOS every timer is scheduled by the kernel timer service and the backend is ignored.
+ */
+int pal_timer_set_backend(pal_timer_t *timer, pal_timer_backend_t backend);
+
+/**
+ * @brief Sets how late a timer may fire so that its expiry shares a wakeup of the timer service with other timers.
+ *
+ * A timer fires between its expiry time and its expiry time plus the slack. The service wakes up at the end of the earliest window and
+ * runs every timer whose window has opened, so timers with overlapping windows cost a single wakeup.
+ *
+ * @param[in] timer Pointer to the timer handle.
+ * @param[in] slack_ms Tolerated lateness in milliseconds, 0 (default) for exact deadlines.
+ * @return 0 on success, or -1 on failure.
+ * @note Wheel timers are already coalesced to PAL_TIMER_WHEEL_TICK_MS and ignore the slack. On freeRTOS the slack is ignored.
+ */
+int pal_timer_set_slack(pal_timer_t *timer, size_t slack_ms);
+
+/**
+ * @brief Sets how long before the expiry of a timer the service wakes up to busy-wait for the exact deadline.
+ *
+ * Waking up from the kernel takes tens of microseconds. Spinning for a short window before the deadline hides that latency for periods
+ * of a few hundred microseconds, at the cost of keeping a CPU busy for the window at each expiry.
+ *
+ * @param[in] timer Pointer to the timer handle.
+ * @param[in] spin_us Busy-wait window in microseconds, 0 (default) to sleep until the deadline.
+ * @return 0 on success, or -1 on failure.
+ * @note Wheel timers ignore the spin window. On freeRTOS the timer service runs at tick granularity and the spin window is ignored.
+ */
+int pal_timer_set_spin(pal_timer_t *timer, size_t spin_us);
+
+/**
+ * @brief Selects how a periodic timer handles the periods it missed.
+ *
+ * Periodic timers are rescheduled from their previous expiry, so the callback runtime and the wakeup latency do not accumulate.
+ *
+ * @param[in] timer Pointer to the timer handle.
+ * @param[in] policy PAL_TIMER_OVERRUN_SKIP (default), PAL_TIMER_OVERRUN_CATCH_UP or PAL_TIMER_OVERRUN_COALESCE.
+ * @return 0 on success, or -1 on failure (e.g., the policy is not supported).
+ * @note On freeRTOS the kernel timer service always catches up, the other policies fail.
+ */
+int pal_timer_set_overrun_policy(pal_timer_t *timer, pal_timer_overrun_policy_t policy);
+
+/**
+ * @brief Gets the number of periods a periodic timer missed since it was last started.
+ *
+ * @param[in] timer Pointer to the timer handle.
+ * @return Number of missed periods.
+ * @note Will return 0 if the timer is NULL, and always on freeRTOS.
+ */
+size_t pal_timer_get_overruns(pal_timer_t *timer);
+
+/**
+ * @brief Selects the context running the callback of a timer.
+ *
+ * @param[in] timer Pointer to the timer handle. Must not be active.
+ * @param[in] dispatch PAL_TIMER_DISPATCH_SERVICE (default), PAL_TIMER_DISPATCH_POOL or PAL_TIMER_DISPATCH_QUEUE.
+ * @param[in] queue Queue of pal_timer_t pointers the expired timer is posted to, used with PAL_TIMER_DISPATCH_QUEUE only.
+ * @param[in] concurrent Non-zero if runs of the callback may overlap, zero to run the expirations of the timer one after another.
+ * @return 0 on success, or -1 on failure (e.g., the timer is active or the pool could not be started).
+ * @note An expiration that does not fit in a full queue is dropped and counted as an overrun.
+ * @note On freeRTOS the kernel timer service runs every callback, only PAL_TIMER_DISPATCH_SERVICE is accepted.
+ */
+int pal_timer_set_dispatch(pal_timer_t *timer, pal_timer_dispatch_t dispatch, pal_queue_t *queue, int concurrent);
+
+/**
+ * @brief Runs the callback of a timer taken from its dispatch queue.
+ *
+ * @param[in] timer Pointer to the timer handle dequeued from the queue set with pal_timer_set_dispatch.
+ * @return 0 on success, or -1 on failure.
+ * @note A timer stopped since it was posted does not run.
+ */
+int pal_timer_run_dispatched(pal_timer_t *timer);
+
+/**
+ * @brief Sets the number of timer service shards.
+ *
+ * Each shard has its own thread, timer structures and lock, so timers of different shards are started, stopped and run in parallel. A
+ * timer is served by the shard of the CPU first creating it, CPU modulo the number of shards, and the thread of a shard runs on those CPUs.
+ *
+ * @param[in] count Number of shards, from 1 (default) to PAL_TIMER_MAX_SHARDS.
+ * @return 0 on success, or -1 on failure (e.g., the timer service is running).
+ * @note Must be called before any timer is created and before the scheduler starts the timer service. On freeRTOS the kernel timer
+ * service is the only shard and only 1 is accepted.
+ */
+int pal_timer_set_shards(size_t count);
+
+/**
+ * @brief Moves a timer to an explicit timer service shard.
+ *
+ * The timer keeps the shard when it is created again.
+ *
+ * @param[in] timer Pointer to the timer handle. Must not be active.
+ * @param[in] shard Index of the shard, lower than the number set with pal_timer_set_shards.
+ * @return 0 on success, or -1 on failure (e.g., the timer is active or its callback is pending).
+ * @note On freeRTOS only shard 0 is accepted.
+ */
+int pal_timer_set_shard(pal_timer_t *timer, size_t shard);
+
 /**
  * @brief Checks if a timer is active.
  *
@@ -151,6 +354,7 @@ int pal_is_timer_active(pal_timer_t *timer);
  *
  * @param[in,out] timer Pointer to the timer handle to be deleted.
  * @return 0 on success, or -1 on failure.
+ * @note Dispatched callbacks still running on other threads are waited for.
  */
 int pal_timer_delete(pal_timer_t *timer);
 
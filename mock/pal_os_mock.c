@@ -40,6 +40,54 @@ DEFINE_FAKE_VALUE_FUNC(int, pal_mutex_lock, pal_mutex_t *, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_mutex_unlock, pal_mutex_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_mutex_destroy, pal_mutex_t *)
 
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_create, pal_cond_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_wait, pal_cond_t *, pal_mutex_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_timedwait, pal_cond_t *, pal_mutex_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_signal, pal_cond_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_broadcast, pal_cond_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_cond_destroy, pal_cond_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_barrier_create, pal_barrier_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_barrier_wait, pal_barrier_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_barrier_destroy, pal_barrier_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_combiner_create, pal_combiner_t *, void *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_combiner_execute, pal_combiner_t *, pal_combiner_op_t *, pal_combiner_func_t, void *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_combiner_destroy, pal_combiner_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_create, pal_epoch_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_register, pal_epoch_t *, pal_epoch_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_unregister, pal_epoch_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_enter, pal_epoch_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_exit, pal_epoch_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_retire, pal_epoch_record_t *, pal_epoch_node_t *, pal_epoch_free_t)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_epoch_reclaim, pal_epoch_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_epoch_destroy, pal_epoch_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_create, pal_hazard_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_register, pal_hazard_t *, pal_hazard_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_unregister, pal_hazard_record_t *)
+DEFINE_FAKE_VALUE_FUNC(void *, pal_hazard_protect, pal_hazard_record_t *, size_t, void *const *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_clear, pal_hazard_record_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_retire, pal_hazard_record_t *, pal_hazard_node_t *, const void *, pal_hazard_free_t)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_hazard_scan, pal_hazard_record_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_hazard_destroy, pal_hazard_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_latch_create, pal_latch_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_latch_count_down, pal_latch_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_latch_wait, pal_latch_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_latch_destroy, pal_latch_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_create, pal_lock_stripe_t *, pal_lock_stripe_slot_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_lock_stripe_index, const pal_lock_stripe_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_lock_key, pal_lock_stripe_t *, size_t, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_unlock_key, pal_lock_stripe_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_lock_all, pal_lock_stripe_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_unlock_all, pal_lock_stripe_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_lock_stripe_destroy, pal_lock_stripe_t *)
+
+DEFINE_FAKE_VALUE_FUNC(int, pal_once_call, pal_once_t *, pal_once_func_t, void *)
+
 DEFINE_FAKE_VALUE_FUNC(int, pal_queue_create, pal_queue_t *, size_t, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_queue_enqueue, pal_queue_t *, void *const, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_queue_dequeue, pal_queue_t *, void *const, size_t)
@@ -48,10 +96,21 @@ DEFINE_FAKE_VALUE_FUNC(size_t, pal_queue_get_free_slots, pal_queue_t *)
 DEFINE_FAKE_VALUE_FUNC(size_t, pal_queue_get_items, pal_queue_t *)
 DEFINE_FAKE_VOID_FUNC(pal_queue_destroy, pal_queue_t *)
 
+DEFINE_FAKE_VALUE_FUNC(int, pal_sem_create, pal_sem_t *, size_t, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_sem_take, pal_sem_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_sem_give, pal_sem_t *)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_sem_get_count, pal_sem_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_sem_destroy, pal_sem_t *)
+
 DEFINE_FAKE_VALUE_FUNC(int, pal_signal_create, pal_signal_t *)
 DEFINE_FAKE_VALUE_FUNC(pal_signal_ret_code_t, pal_signal_wait, pal_signal_t *, size_t, size_t *, int, int, size_t)
+DEFINE_FAKE_VALUE_FUNC(pal_signal_ret_code_t, pal_signal_wait_multi, pal_signal_wait_entry_t *, size_t, size_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(pal_signal_ret_code_t, pal_signal_sync, pal_signal_t *, size_t, size_t, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_signal_set, pal_signal_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_signal_set_from_isr, pal_signal_t *, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_signal_clear, pal_signal_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_signal_enable_stats, pal_signal_t *, pal_signal_stats_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_signal_get_stats, pal_signal_t *, pal_signal_stats_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_signal_destroy, pal_signal_t *)
 
 DEFINE_FAKE_VOID_FUNC_VARARG(pal_system_printf, const char *, ...)
@@ -63,6 +122,8 @@ DEFINE_FAKE_VOID_FUNC(pal_thread_scheduler_start)
 DEFINE_FAKE_VOID_FUNC(pal_thread_join, pal_thread_t *const)
 DEFINE_FAKE_VALUE_FUNC(const char *, pal_thread_get_name, pal_thread_t *const)
 DEFINE_FAKE_VALUE_FUNC(size_t, pal_thread_get_stack_watermark, pal_thread_t *const)
+DEFINE_FAKE_VALUE_FUNC(int, pal_thread_notify, pal_thread_t *const, uint32_t, pal_thread_notify_action_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_thread_notify_wait, uint32_t, uint32_t, uint32_t *, size_t)
 DEFINE_FAKE_VOID_FUNC(pal_thread_free, pal_thread_t *)
 
 DEFINE_FAKE_VALUE_FUNC(size_t, pal_get_unix_time)
@@ -70,9 +131,21 @@ DEFINE_FAKE_VOID_FUNC(pal_set_unix_time, size_t)
 DEFINE_FAKE_VALUE_FUNC(size_t, pal_get_system_time)
 
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_create, pal_timer_t *, const char *, pal_timer_type_t, size_t, pal_timer_callback_t, int, void *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_create_us, pal_timer_t *, const char *, pal_timer_type_t, size_t, pal_timer_callback_t, int, void *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_start, pal_timer_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_stop, pal_timer_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_restart, pal_timer_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_change_period, pal_timer_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_change_period_us, pal_timer_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_timer_get_resolution_us)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_backend, pal_timer_t *, pal_timer_backend_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_slack, pal_timer_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_spin, pal_timer_t *, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_overrun_policy, pal_timer_t *, pal_timer_overrun_policy_t)
+DEFINE_FAKE_VALUE_FUNC(size_t, pal_timer_get_overruns, pal_timer_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_dispatch, pal_timer_t *, pal_timer_dispatch_t, pal_queue_t *, int)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_run_dispatched, pal_timer_t *)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_shards, size_t)
+DEFINE_FAKE_VALUE_FUNC(int, pal_timer_set_shard, pal_timer_t *, size_t)
 DEFINE_FAKE_VALUE_FUNC(int, pal_is_timer_active, pal_timer_t *)
 DEFINE_FAKE_VALUE_FUNC(int, pal_timer_delete, pal_timer_t *)
\ No newline at end of file
@@ -8,8 +8,21 @@ set(sources
     ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/system.c
     ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/time.c
     ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/timer.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/cond.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/sem.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/barrier.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/latch.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/${TARGET_PLATFORM}/once.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/common/lock_stripe.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/common/combiner.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/common/epoch.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/common/hazard.c
 )
 
+if(${TARGET_PLATFORM} STREQUAL "freeRTOS")
+    list(APPEND sources ${CMAKE_CURRENT_LIST_DIR}/src/freeRTOS/atomic.c)
+endif()
+
 set(public_includes
     ${CMAKE_CURRENT_LIST_DIR}/include
 )
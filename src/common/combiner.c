@@ -0,0 +1,133 @@
+/*
+ * File: combiner.c
+ * Description: Implementation of the flat-combining executor, common to every platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/combiner.h"
+
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Apply the pending operations in batches, with the combiner lock held.
+ * @param[in] combiner Pointer to the combiner.
+ */
+static void pal_combiner_combine(pal_combiner_t *combiner)
+{
+	for (int pass = 0; pass < PAL_COMBINER_MAX_PASSES; pass++)
+	{
+		pal_combiner_op_t *batch = (pal_combiner_op_t *)pal_atomic_ptr_exchange((void **)&combiner->pending, NULL, PAL_ATOMIC_ACQUIRE);
+		pal_combiner_op_t *fifo	 = NULL;
+		if (NULL == batch)
+		{
+			break;
+		}
+		// The stack holds the newest operation first: reverse it to apply operations in publication order
+		while (batch)
+		{
+			pal_combiner_op_t *next = batch->next;
+			batch->next				= fifo;
+			fifo					= batch;
+			batch					= next;
+		}
+		while (fifo)
+		{
+			// The record belongs to its publisher again as soon as done is set, so it must not be read afterwards
+			pal_combiner_op_t *next = fifo->next;
+			fifo->func(combiner->object, fifo->arg);
+			pal_atomic_u32_store(&fifo->done, 1, PAL_ATOMIC_RELEASE);
+			fifo = next;
+		}
+	}
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_combiner_create(pal_combiner_t *combiner, void *object)
+{
+	int ret_code = -1;
+	if (combiner)
+	{
+		combiner->pending = NULL;
+		combiner->object  = object;
+		ret_code		  = pal_mutex_create(&combiner->lock, 0);
+	}
+	return ret_code;
+}
+
+int pal_combiner_execute(pal_combiner_t *combiner, pal_combiner_op_t *op, pal_combiner_func_t func, void *arg)
+{
+	int ret_code = -1;
+	if (combiner && op && func)
+	{
+		op->func		   = func;
+		op->arg			   = arg;
+		op->done		   = 0;
+		op->next		   = (pal_combiner_op_t *)pal_atomic_ptr_load((void *const *)&combiner->pending, PAL_ATOMIC_RELAXED);
+		while (!pal_atomic_ptr_compare_exchange((void **)&combiner->pending, (void **)&op->next, op, PAL_ATOMIC_RELEASE))
+		{
+		}
+		ret_code = 0;
+		// Become the combiner if nobody is, otherwise give the current one a chance to apply the operation before sleeping
+		bool locked = false;
+		for (int spin = 0; !locked && !pal_atomic_u32_load(&op->done, PAL_ATOMIC_ACQUIRE); spin++)
+		{
+			if (spin < PAL_COMBINER_SPIN_COUNT)
+			{
+				locked = 0 == pal_mutex_lock(&combiner->lock, PAL_OS_NO_TIMEOUT);
+				pal_cpu_relax();
+			}
+			else
+			{
+				locked = 0 == pal_mutex_lock(&combiner->lock, PAL_OS_INFINITE_TIMEOUT);
+			}
+		}
+		if (locked)
+		{
+			// The operation is either still pending or was applied by the previous combiner after the lock was taken
+			if (!pal_atomic_u32_load(&op->done, PAL_ATOMIC_ACQUIRE))
+			{
+				pal_combiner_combine(combiner);
+			}
+			pal_mutex_unlock(&combiner->lock);
+		}
+	}
+	return ret_code;
+}
+
+int pal_combiner_destroy(pal_combiner_t *combiner)
+{
+	int ret_code = -1;
+	if (combiner && NULL == pal_atomic_ptr_load((void *const *)&combiner->pending, PAL_ATOMIC_ACQUIRE))
+	{
+		ret_code = pal_mutex_destroy(&combiner->lock);
+	}
+	return ret_code;
+}
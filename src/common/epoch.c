@@ -0,0 +1,267 @@
+/*
+ * File: epoch.c
+ * Description: Implementation of epoch-based memory reclamation, common to every platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/epoch.h"
+
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_EPOCH_MASK			 0x7FFFFFFFu  //!< Epochs wrap on 31 bits, so that they fit in a record state next to the active flag
+#define PAL_EPOCH_ACTIVE		 1u			  //!< Record state flag set inside a read-side section
+#define PAL_EPOCH_GRACE_PERIOD	 2u			  //!< Epoch advances after which no reader can still access a retired object
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Advance the global epoch if every thread inside a read-side section has observed the current one.
+ * @param[in] epoch Pointer to the domain.
+ * @note Gives up immediately if another thread is already scanning the records.
+ */
+static void pal_epoch_try_advance(pal_epoch_t *epoch)
+{
+	if (0 == pal_mutex_lock(&epoch->lock, PAL_OS_NO_TIMEOUT))
+	{
+		uint32_t current = pal_atomic_u32_load(&epoch->epoch, PAL_ATOMIC_RELAXED);
+		bool	 advance = true;
+		// Pairs with the fence of pal_epoch_enter: either the scan sees the reader, or the reader sees every unlink done before it
+		pal_atomic_fence(PAL_ATOMIC_SEQ_CST);
+		for (pal_epoch_record_t *record = epoch->records; record && advance; record = record->next)
+		{
+			uint32_t state = pal_atomic_u32_load(&record->state, PAL_ATOMIC_ACQUIRE);
+			advance		   = !(state & PAL_EPOCH_ACTIVE) || (state >> 1) == current;
+		}
+		if (advance)
+		{
+			pal_atomic_u32_store(&epoch->epoch, (current + 1) & PAL_EPOCH_MASK, PAL_ATOMIC_RELEASE);
+		}
+		pal_mutex_unlock(&epoch->lock);
+	}
+}
+
+/**
+ * @brief Release a list of objects.
+ * @param[in] node First object of the list.
+ * @return Number of objects released.
+ */
+static size_t pal_epoch_release(pal_epoch_node_t *node)
+{
+	size_t released = 0;
+	while (node)
+	{
+		pal_epoch_node_t *next = node->next;
+		node->free_fn(node);
+		node = next;
+		released++;
+	}
+	return released;
+}
+
+/**
+ * @brief Release the objects left by unregistered threads whose grace period has elapsed.
+ * @param[in] epoch Pointer to the domain.
+ * @param[in] current Current global epoch.
+ * @return Number of objects released.
+ * @note Gives up immediately if another thread holds the domain lock, a later call releases the objects.
+ */
+static size_t pal_epoch_reclaim_orphans(pal_epoch_t *epoch, uint32_t current)
+{
+	pal_epoch_node_t *expired = NULL;
+	if (0 == pal_mutex_lock(&epoch->lock, PAL_OS_NO_TIMEOUT))
+	{
+		// The orphans of several threads are not sorted, every one is checked
+		pal_epoch_node_t **link = &epoch->orphans;
+		while (*link)
+		{
+			pal_epoch_node_t *node = *link;
+			if (((current - node->epoch) & PAL_EPOCH_MASK) < PAL_EPOCH_GRACE_PERIOD)
+			{
+				link = &node->next;
+			}
+			else
+			{
+				*link	   = node->next;
+				node->next = expired;
+				expired	   = node;
+			}
+		}
+		pal_mutex_unlock(&epoch->lock);
+	}
+	return pal_epoch_release(expired);
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_epoch_create(pal_epoch_t *epoch)
+{
+	int ret_code = -1;
+	if (epoch)
+	{
+		epoch->epoch   = 0;
+		epoch->records = NULL;
+		epoch->orphans = NULL;
+		ret_code	   = pal_mutex_create(&epoch->lock, 0);
+	}
+	return ret_code;
+}
+
+int pal_epoch_register(pal_epoch_t *epoch, pal_epoch_record_t *record)
+{
+	int ret_code = -1;
+	if (epoch && record && 0 == pal_mutex_lock(&epoch->lock, PAL_OS_INFINITE_TIMEOUT))
+	{
+		record->domain		  = epoch;
+		record->state		  = 0;
+		record->nesting		  = 0;
+		record->retired		  = NULL;
+		record->retired_count = 0;
+		record->next		  = epoch->records;
+		epoch->records		  = record;
+		pal_mutex_unlock(&epoch->lock);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_epoch_unregister(pal_epoch_record_t *record)
+{
+	int ret_code = -1;
+	if (record && record->domain && 0 == record->nesting)
+	{
+		pal_epoch_t *epoch = record->domain;
+		pal_epoch_reclaim(record);
+		if (0 == pal_mutex_lock(&epoch->lock, PAL_OS_INFINITE_TIMEOUT))
+		{
+			pal_epoch_record_t **link = &epoch->records;
+			while (*link && *link != record)
+			{
+				link = &(*link)->next;
+			}
+			if (*link)
+			{
+				*link	 = record->next;
+				ret_code = 0;
+			}
+			// The objects still in their grace period need the other readers to move on, the domain releases them later
+			while (record->retired)
+			{
+				pal_epoch_node_t *node = record->retired;
+				record->retired		   = node->next;
+				node->next			   = epoch->orphans;
+				epoch->orphans		   = node;
+			}
+			record->retired_count = 0;
+			pal_mutex_unlock(&epoch->lock);
+			record->domain = NULL;
+		}
+	}
+	return ret_code;
+}
+
+int pal_epoch_enter(pal_epoch_record_t *record)
+{
+	int ret_code = -1;
+	if (record && record->domain)
+	{
+		if (0 == record->nesting++)
+		{
+			uint32_t current = pal_atomic_u32_load(&record->domain->epoch, PAL_ATOMIC_ACQUIRE);
+			pal_atomic_u32_store(&record->state, (current << 1) | PAL_EPOCH_ACTIVE, PAL_ATOMIC_RELAXED);
+			// The state must be visible before any shared pointer is read
+			pal_atomic_fence(PAL_ATOMIC_SEQ_CST);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_epoch_exit(pal_epoch_record_t *record)
+{
+	int ret_code = -1;
+	if (record && record->nesting)
+	{
+		if (0 == --record->nesting)
+		{
+			pal_atomic_u32_store(&record->state, 0, PAL_ATOMIC_RELEASE);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_epoch_retire(pal_epoch_record_t *record, pal_epoch_node_t *node, pal_epoch_free_t free_fn)
+{
+	int ret_code = -1;
+	if (record && record->domain && node && free_fn)
+	{
+		node->free_fn	= free_fn;
+		node->epoch		= pal_atomic_u32_load(&record->domain->epoch, PAL_ATOMIC_ACQUIRE);
+		node->next		= record->retired;
+		record->retired = node;
+		if (0 == ++record->retired_count % PAL_EPOCH_RECLAIM_THRESHOLD)
+		{
+			pal_epoch_reclaim(record);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+size_t pal_epoch_reclaim(pal_epoch_record_t *record)
+{
+	size_t released = 0;
+	if (record && record->domain)
+	{
+		pal_epoch_try_advance(record->domain);
+		uint32_t		   current = pal_atomic_u32_load(&record->domain->epoch, PAL_ATOMIC_ACQUIRE);
+		pal_epoch_node_t **link	   = &record->retired;
+		// The list is sorted from the newest retirement: once an object is old enough, so are all the following ones
+		while (*link && ((current - (*link)->epoch) & PAL_EPOCH_MASK) < PAL_EPOCH_GRACE_PERIOD)
+		{
+			link = &(*link)->next;
+		}
+		pal_epoch_node_t *node = *link;
+		*link				   = NULL;
+		released			   = pal_epoch_release(node);
+		record->retired_count -= released;
+		released += pal_epoch_reclaim_orphans(record->domain, current);
+	}
+	return released;
+}
+
+int pal_epoch_destroy(pal_epoch_t *epoch)
+{
+	int ret_code = -1;
+	if (epoch && NULL == epoch->records)
+	{
+		pal_epoch_release(epoch->orphans);
+		epoch->orphans = NULL;
+		ret_code	   = pal_mutex_destroy(&epoch->lock);
+	}
+	return ret_code;
+}
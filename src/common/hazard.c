@@ -0,0 +1,223 @@
+/*
+ * File: hazard.c
+ * Description: Implementation of hazard pointer memory reclamation, common to every platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/hazard.h"
+
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+#include "pal_os/thread.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_HAZARD_UNREGISTER_MS 1	//!< Sleep between two scans while unregistering
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Check whether any registered thread protects an object.
+ * @param[in] hazard Pointer to the domain, with the records list locked.
+ * @param[in] ptr Address of the object.
+ * @return true if a slot holds the address, false otherwise.
+ */
+static bool pal_hazard_is_protected(pal_hazard_t *hazard, const void *ptr)
+{
+	bool protected_ptr = false;
+	for (pal_hazard_record_t *record = hazard->records; record && !protected_ptr; record = record->next)
+	{
+		for (size_t slot = 0; slot < PAL_HAZARD_SLOTS && !protected_ptr; slot++)
+		{
+			protected_ptr = ptr == pal_atomic_ptr_load(&record->slots[slot], PAL_ATOMIC_ACQUIRE);
+		}
+	}
+	return protected_ptr;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_hazard_create(pal_hazard_t *hazard)
+{
+	int ret_code = -1;
+	if (hazard)
+	{
+		hazard->records = NULL;
+		ret_code		= pal_mutex_create(&hazard->lock, 0);
+	}
+	return ret_code;
+}
+
+int pal_hazard_register(pal_hazard_t *hazard, pal_hazard_record_t *record)
+{
+	int ret_code = -1;
+	if (hazard && record && 0 == pal_mutex_lock(&hazard->lock, PAL_OS_INFINITE_TIMEOUT))
+	{
+		for (size_t slot = 0; slot < PAL_HAZARD_SLOTS; slot++)
+		{
+			record->slots[slot] = NULL;
+		}
+		record->domain		  = hazard;
+		record->retired		  = NULL;
+		record->retired_count  = 0;
+		record->scan_threshold = PAL_HAZARD_SCAN_THRESHOLD;
+		record->next		  = hazard->records;
+		hazard->records		  = record;
+		pal_mutex_unlock(&hazard->lock);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_hazard_unregister(pal_hazard_record_t *record)
+{
+	int ret_code = -1;
+	if (record && record->domain)
+	{
+		pal_hazard_t *hazard = record->domain;
+		for (size_t slot = 0; slot < PAL_HAZARD_SLOTS; slot++)
+		{
+			pal_hazard_clear(record, slot);
+		}
+		pal_hazard_scan(record);
+		while (record->retired)
+		{
+			// The remaining objects are still protected by other threads
+			pal_thread_sleep(PAL_HAZARD_UNREGISTER_MS);
+			pal_hazard_scan(record);
+		}
+		if (0 == pal_mutex_lock(&hazard->lock, PAL_OS_INFINITE_TIMEOUT))
+		{
+			pal_hazard_record_t **link = &hazard->records;
+			while (*link && *link != record)
+			{
+				link = &(*link)->next;
+			}
+			if (*link)
+			{
+				*link	 = record->next;
+				ret_code = 0;
+			}
+			pal_mutex_unlock(&hazard->lock);
+			record->domain = NULL;
+		}
+	}
+	return ret_code;
+}
+
+void *pal_hazard_protect(pal_hazard_record_t *record, size_t slot, void *const *src)
+{
+	void *ptr = NULL;
+	if (record && slot < PAL_HAZARD_SLOTS && src)
+	{
+		void *published = pal_atomic_ptr_load(src, PAL_ATOMIC_RELAXED);
+		do
+		{
+			ptr = published;
+			pal_atomic_ptr_store(&record->slots[slot], ptr, PAL_ATOMIC_RELAXED);
+			// The hazard must be visible to the scanners before the pointer is validated
+			pal_atomic_fence(PAL_ATOMIC_SEQ_CST);
+			published = pal_atomic_ptr_load(src, PAL_ATOMIC_ACQUIRE);
+		} while (published != ptr);
+	}
+	return ptr;
+}
+
+int pal_hazard_clear(pal_hazard_record_t *record, size_t slot)
+{
+	int ret_code = -1;
+	if (record && slot < PAL_HAZARD_SLOTS)
+	{
+		pal_atomic_ptr_store(&record->slots[slot], NULL, PAL_ATOMIC_RELEASE);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_hazard_retire(pal_hazard_record_t *record, pal_hazard_node_t *node, const void *ptr, pal_hazard_free_t free_fn)
+{
+	int ret_code = -1;
+	if (record && record->domain && node && free_fn)
+	{
+		node->free_fn	= free_fn;
+		node->ptr		= ptr;
+		node->next		= record->retired;
+		record->retired = node;
+		if (++record->retired_count >= record->scan_threshold)
+		{
+			pal_hazard_scan(record);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+size_t pal_hazard_scan(pal_hazard_record_t *record)
+{
+	size_t			   released = 0;
+	pal_hazard_node_t *freed	= NULL;
+	if (record && record->domain && 0 == pal_mutex_lock(&record->domain->lock, PAL_OS_INFINITE_TIMEOUT))
+	{
+		pal_hazard_node_t **link = &record->retired;
+		// Pairs with the fence of pal_hazard_protect: either the slot is seen here, or the reader sees the object unlinked
+		pal_atomic_fence(PAL_ATOMIC_SEQ_CST);
+		while (*link)
+		{
+			pal_hazard_node_t *node = *link;
+			if (pal_hazard_is_protected(record->domain, node->ptr))
+			{
+				link = &node->next;
+			}
+			else
+			{
+				*link	   = node->next;
+				node->next = freed;
+				freed	   = node;
+				released++;
+			}
+		}
+		pal_mutex_unlock(&record->domain->lock);
+		record->retired_count -= released;
+		// The objects still protected do not count towards the next scan, otherwise every retire would scan again
+		record->scan_threshold = record->retired_count + PAL_HAZARD_SCAN_THRESHOLD;
+		// A free function may retire or scan again, so it runs without the domain lock
+		while (freed)
+		{
+			pal_hazard_node_t *node = freed;
+			freed					= node->next;
+			node->free_fn(node);
+		}
+	}
+	return released;
+}
+
+int pal_hazard_destroy(pal_hazard_t *hazard)
+{
+	int ret_code = -1;
+	if (hazard && NULL == hazard->records)
+	{
+		ret_code = pal_mutex_destroy(&hazard->lock);
+	}
+	return ret_code;
+}
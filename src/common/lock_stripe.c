@@ -0,0 +1,171 @@
+/*
+ * File: lock_stripe.c
+ * Description: Implementation of the striped lock array, common to every platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/lock_stripe.h"
+
+#include <stdint.h>
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Mix the bits of a key, so that keys differing only in a few bits land on unrelated slots.
+ * @param[in] key Key to mix.
+ * @return 32-bit hash of the key.
+ * @note Finalizer of MurmurHash3.
+ */
+static uint32_t pal_lock_stripe_hash(size_t key)
+{
+	uint64_t hash = (uint64_t)key;
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDull;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB9FE1A85EC53ull;
+	hash ^= hash >> 33;
+	return (uint32_t)(hash >> 32);
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_lock_stripe_create(pal_lock_stripe_t *stripe, pal_lock_stripe_slot_t *slots, size_t count)
+{
+	int ret_code = -1;
+	if (stripe && slots && count)
+	{
+		size_t index = 0;
+		ret_code	 = 0;
+		for (index = 0; index < count && 0 == ret_code; index++)
+		{
+			ret_code = pal_mutex_create(&slots[index].mutex, 0);
+		}
+		if (0 == ret_code)
+		{
+			stripe->slots = slots;
+			stripe->count = count;
+		}
+		else
+		{
+			// Release the locks created before the failing one
+			for (index--; index > 0; index--)
+			{
+				pal_mutex_destroy(&slots[index - 1].mutex);
+			}
+		}
+	}
+	return ret_code;
+}
+
+size_t pal_lock_stripe_index(const pal_lock_stripe_t *stripe, size_t key)
+{
+	size_t index = 0;
+	if (stripe && stripe->count)
+	{
+		// Multiply and shift maps the hash on [0, count) without the division of a modulo
+		index = (size_t)(((uint64_t)pal_lock_stripe_hash(key) * stripe->count) >> 32);
+	}
+	return index;
+}
+
+int pal_lock_stripe_lock_key(pal_lock_stripe_t *stripe, size_t key, size_t timeout_ms)
+{
+	int ret_code = -1;
+	if (stripe && stripe->slots)
+	{
+		ret_code = pal_mutex_lock(&stripe->slots[pal_lock_stripe_index(stripe, key)].mutex, timeout_ms);
+	}
+	return ret_code;
+}
+
+int pal_lock_stripe_unlock_key(pal_lock_stripe_t *stripe, size_t key)
+{
+	int ret_code = -1;
+	if (stripe && stripe->slots)
+	{
+		ret_code = pal_mutex_unlock(&stripe->slots[pal_lock_stripe_index(stripe, key)].mutex);
+	}
+	return ret_code;
+}
+
+int pal_lock_stripe_lock_all(pal_lock_stripe_t *stripe)
+{
+	int ret_code = -1;
+	if (stripe && stripe->slots)
+	{
+		size_t index = 0;
+		ret_code	 = 0;
+		for (index = 0; index < stripe->count && 0 == ret_code; index++)
+		{
+			ret_code = pal_mutex_lock(&stripe->slots[index].mutex, PAL_OS_INFINITE_TIMEOUT);
+		}
+		if (0 != ret_code)
+		{
+			for (index--; index > 0; index--)
+			{
+				pal_mutex_unlock(&stripe->slots[index - 1].mutex);
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_lock_stripe_unlock_all(pal_lock_stripe_t *stripe)
+{
+	int ret_code = -1;
+	if (stripe && stripe->slots)
+	{
+		ret_code = 0;
+		for (size_t index = stripe->count; index > 0; index--)
+		{
+			if (0 != pal_mutex_unlock(&stripe->slots[index - 1].mutex))
+			{
+				ret_code = -1;
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_lock_stripe_destroy(pal_lock_stripe_t *stripe)
+{
+	int ret_code = -1;
+	if (stripe && stripe->slots)
+	{
+		ret_code = 0;
+		for (size_t index = 0; index < stripe->count; index++)
+		{
+			if (0 != pal_mutex_destroy(&stripe->slots[index].mutex))
+			{
+				ret_code = -1;
+			}
+		}
+		stripe->slots = NULL;
+		stripe->count = 0;
+	}
+	return ret_code;
+}
@@ -0,0 +1,64 @@
+/*
+ * File: atomic.c
+ * Description: Critical section used to emulate atomic operations on the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/atomic.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+#ifdef ESP_PLATFORM
+static portMUX_TYPE pal_atomic_mux = portMUX_INITIALIZER_UNLOCKED;	//!< Spinlock shared by every core
+#endif
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+PAL_OS_RAM_ATTR uint32_t pal_atomic_lock(void)
+{
+#ifdef ESP_PLATFORM
+	// Masking interrupts is not enough on multi-core chips, the spinlock also excludes the other core
+	portENTER_CRITICAL_SAFE(&pal_atomic_mux);
+	return 0;
+#else
+	return (uint32_t)portSET_INTERRUPT_MASK_FROM_ISR();
+#endif
+}
+
+PAL_OS_RAM_ATTR void pal_atomic_unlock(uint32_t state)
+{
+#ifdef ESP_PLATFORM
+	(void)state;
+	portEXIT_CRITICAL_SAFE(&pal_atomic_mux);
+#else
+	portCLEAR_INTERRUPT_MASK_FROM_ISR((UBaseType_t)state);
+#endif
+}
@@ -0,0 +1,122 @@
+/*
+ * File: barrier.c
+ * Description: Implementation of barrier functionality for the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/barrier.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_BARRIER_ROUND_BIT(generation) ((EventBits_t)1 << ((generation) & 1))  //!< Event bit released when the given round completes
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Get the event group of the barrier, creating it on first use for statically initialized barriers.
+ * @param[in] barrier Pointer to the barrier.
+ * @return Event group handle, or NULL if it could not be created.
+ */
+static EventGroupHandle_t pal_barrier_get_handle(pal_barrier_t *barrier)
+{
+	EventGroupHandle_t handle = (EventGroupHandle_t)pal_atomic_ptr_load((void *const *)&barrier->group, PAL_ATOMIC_ACQUIRE);
+	if (NULL == handle)
+	{
+		EventGroupHandle_t created = xEventGroupCreate();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&barrier->group, (void **)&handle, created, PAL_ATOMIC_ACQ_REL))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its event group
+				vEventGroupDelete(created);
+			}
+		}
+	}
+	return handle;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_barrier_create(pal_barrier_t *barrier, size_t count)
+{
+	int ret_code = -1;
+	if (barrier && count && count <= UINT32_MAX)
+	{
+		barrier->count		= (uint32_t)count;
+		barrier->arrived	= 0;
+		barrier->generation = 0;
+		barrier->group		= xEventGroupCreate();
+		ret_code			= barrier->group ? 0 : -1;
+	}
+	return ret_code;
+}
+
+int pal_barrier_wait(pal_barrier_t *barrier)
+{
+	int				   ret_code = -1;
+	EventGroupHandle_t group	= barrier ? pal_barrier_get_handle(barrier) : NULL;
+	if (group && barrier->count)
+	{
+		// Consecutive rounds release alternate bits, so a late waiter of the previous round never sees the next one
+		uint32_t generation = pal_atomic_u32_load(&barrier->generation, PAL_ATOMIC_ACQUIRE);
+		if (barrier->count - 1 == pal_atomic_u32_fetch_add(&barrier->arrived, 1, PAL_ATOMIC_ACQ_REL))
+		{
+			// Every task already left the previous round, its bit can be rearmed for the next one
+			pal_atomic_u32_store(&barrier->arrived, 0, PAL_ATOMIC_RELAXED);
+			xEventGroupClearBits(group, PAL_BARRIER_ROUND_BIT(generation + 1));
+			pal_atomic_u32_store(&barrier->generation, generation + 1, PAL_ATOMIC_RELEASE);
+			xEventGroupSetBits(group, PAL_BARRIER_ROUND_BIT(generation));
+			ret_code = PAL_BARRIER_SERIAL_THREAD;
+		}
+		else
+		{
+			xEventGroupWaitBits(group, PAL_BARRIER_ROUND_BIT(generation), pdFALSE, pdTRUE, portMAX_DELAY);
+			ret_code = 0;
+		}
+	}
+	return ret_code;
+}
+
+int pal_barrier_destroy(pal_barrier_t *barrier)
+{
+	int ret_code = -1;
+	if (barrier)
+	{
+		if (barrier->group)
+		{
+			vEventGroupDelete(barrier->group);
+			barrier->group = NULL;
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
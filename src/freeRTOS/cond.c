@@ -0,0 +1,200 @@
+/*
+ * File: cond.c
+ * Description: Implementation of condition variable functionality for the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/cond.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_COND_MAX_WAKEUPS ((UBaseType_t)-1)	//!< Maximum count of the semaphore the waiters block on
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Get a semaphore of the condition variable, creating it on first use for statically initialized objects.
+ * @param[in,out] handle Pointer to the semaphore handle.
+ * @param[in] counting Non-zero for the counting semaphore, zero for the mutex.
+ * @return Semaphore handle, or NULL if it could not be created.
+ */
+static SemaphoreHandle_t pal_cond_get_handle(SemaphoreHandle_t *handle, int counting)
+{
+	SemaphoreHandle_t current = (SemaphoreHandle_t)pal_atomic_ptr_load((void *const *)handle, PAL_ATOMIC_ACQUIRE);
+	if (NULL == current)
+	{
+		SemaphoreHandle_t created = counting ? xSemaphoreCreateCounting(PAL_COND_MAX_WAKEUPS, 0) : xSemaphoreCreateMutex();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)handle, (void **)&current, created, PAL_ATOMIC_ACQ_REL))
+			{
+				current = created;
+			}
+			else
+			{
+				// Another task won the race, keep its semaphore
+				vSemaphoreDelete(created);
+			}
+		}
+	}
+	return current;
+}
+
+/**
+ * @brief Give the semaphore once for up to count waiters.
+ * @param[in] cond Pointer to the condition variable.
+ * @param[in] count Maximum number of waiters to wake.
+ * @return 0 on success, or -1 on failure.
+ */
+static int pal_cond_wake(pal_cond_t *cond, UBaseType_t count)
+{
+	int				  ret_code = -1;
+	SemaphoreHandle_t lock	   = pal_cond_get_handle(&cond->lock, 0);
+	SemaphoreHandle_t sem	   = pal_cond_get_handle(&cond->sem, 1);
+	if (lock && sem)
+	{
+		xSemaphoreTake(lock, portMAX_DELAY);
+		while (count && cond->waiters)
+		{
+			cond->waiters--;
+			count--;
+			xSemaphoreGive(sem);
+		}
+		xSemaphoreGive(lock);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_cond_create(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		cond->waiters = 0;
+		cond->lock	  = xSemaphoreCreateMutex();
+		cond->sem	  = xSemaphoreCreateCounting(PAL_COND_MAX_WAKEUPS, 0);
+		if (cond->lock && cond->sem)
+		{
+			ret_code = 0;
+		}
+		else
+		{
+			pal_cond_destroy(cond);
+		}
+	}
+	return ret_code;
+}
+
+int pal_cond_wait(pal_cond_t *cond, pal_mutex_t *mutex) { return pal_cond_timedwait(cond, mutex, PAL_OS_INFINITE_TIMEOUT); }
+
+int pal_cond_timedwait(pal_cond_t *cond, pal_mutex_t *mutex, size_t timeout_ms)
+{
+	int				  ret_code = -1;
+	SemaphoreHandle_t lock	   = cond ? pal_cond_get_handle(&cond->lock, 0) : NULL;
+	SemaphoreHandle_t sem	   = cond ? pal_cond_get_handle(&cond->sem, 1) : NULL;
+	if (lock && sem && mutex)
+	{
+		TickType_t timeout_ticks = portMAX_DELAY;
+		if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+		{
+			timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+		}
+		xSemaphoreTake(lock, portMAX_DELAY);
+		cond->waiters++;
+		xSemaphoreGive(lock);
+		if (0 == pal_mutex_unlock(mutex))
+		{
+			BaseType_t woken = xSemaphoreTake(sem, timeout_ticks);
+			if (pdTRUE != woken)
+			{
+				// Every wakeup is given while holding the lock: either a signal raced with the timeout and its token is already
+				// available, or this task is still accounted as a waiter and must withdraw
+				xSemaphoreTake(lock, portMAX_DELAY);
+				woken = xSemaphoreTake(sem, 0);
+				if (pdTRUE != woken)
+				{
+					cond->waiters--;
+				}
+				xSemaphoreGive(lock);
+			}
+			ret_code = pdTRUE == woken ? 0 : -1;
+			pal_mutex_lock(mutex, PAL_OS_INFINITE_TIMEOUT);
+		}
+		else
+		{
+			xSemaphoreTake(lock, portMAX_DELAY);
+			cond->waiters--;
+			xSemaphoreGive(lock);
+		}
+	}
+	return ret_code;
+}
+
+int pal_cond_signal(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		ret_code = pal_cond_wake(cond, 1);
+	}
+	return ret_code;
+}
+
+int pal_cond_broadcast(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		ret_code = pal_cond_wake(cond, PAL_COND_MAX_WAKEUPS);
+	}
+	return ret_code;
+}
+
+int pal_cond_destroy(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		if (cond->sem)
+		{
+			vSemaphoreDelete(cond->sem);
+			cond->sem = NULL;
+		}
+		if (cond->lock)
+		{
+			vSemaphoreDelete(cond->lock);
+			cond->lock = NULL;
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
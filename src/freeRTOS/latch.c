@@ -0,0 +1,144 @@
+/*
+ * File: latch.c
+ * Description: Implementation of countdown latch functionality for the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/latch.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_LATCH_OPEN_BIT ((EventBits_t)1)	 //!< Event bit set when the count reaches 0
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Get the event group of the latch, creating it on first use for statically initialized latches.
+ * @param[in] latch Pointer to the latch.
+ * @return Event group handle, or NULL if it could not be created.
+ */
+static EventGroupHandle_t pal_latch_get_handle(pal_latch_t *latch)
+{
+	EventGroupHandle_t handle = (EventGroupHandle_t)pal_atomic_ptr_load((void *const *)&latch->group, PAL_ATOMIC_ACQUIRE);
+	if (NULL == handle)
+	{
+		EventGroupHandle_t created = xEventGroupCreate();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&latch->group, (void **)&handle, created, PAL_ATOMIC_ACQ_REL))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its event group
+				vEventGroupDelete(created);
+			}
+		}
+	}
+	return handle;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_latch_create(pal_latch_t *latch, size_t count)
+{
+	int ret_code = -1;
+	if (latch && count <= UINT32_MAX)
+	{
+		latch->count = (uint32_t)count;
+		latch->group = xEventGroupCreate();
+		ret_code	 = latch->group ? 0 : -1;
+	}
+	return ret_code;
+}
+
+int pal_latch_count_down(pal_latch_t *latch)
+{
+	int				   ret_code = -1;
+	EventGroupHandle_t group	= latch ? pal_latch_get_handle(latch) : NULL;
+	if (group)
+	{
+		uint32_t count = pal_atomic_u32_load(&latch->count, PAL_ATOMIC_RELAXED);
+		while (count)
+		{
+			if (pal_atomic_u32_compare_exchange(&latch->count, &count, count - 1, PAL_ATOMIC_RELEASE))
+			{
+				if (1 == count)
+				{
+					xEventGroupSetBits(group, PAL_LATCH_OPEN_BIT);
+				}
+				ret_code = 0;
+				break;
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_latch_wait(pal_latch_t *latch, size_t timeout_ms)
+{
+	int ret_code = -1;
+	if (latch)
+	{
+		if (0 == pal_atomic_u32_load(&latch->count, PAL_ATOMIC_ACQUIRE))
+		{
+			ret_code = 0;
+		}
+		else if (PAL_OS_NO_TIMEOUT != timeout_ms)
+		{
+			EventGroupHandle_t group = pal_latch_get_handle(latch);
+			if (group)
+			{
+				TickType_t timeout_ticks = portMAX_DELAY;
+				if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+				{
+					timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+				}
+				xEventGroupWaitBits(group, PAL_LATCH_OPEN_BIT, pdFALSE, pdTRUE, timeout_ticks);
+				ret_code = 0 == pal_atomic_u32_load(&latch->count, PAL_ATOMIC_ACQUIRE) ? 0 : -1;
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_latch_destroy(pal_latch_t *latch)
+{
+	int ret_code = -1;
+	if (latch)
+	{
+		if (latch->group)
+		{
+			vEventGroupDelete(latch->group);
+			latch->group = NULL;
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
@@ -8,6 +8,7 @@
 
 #include <string.h>
 
+#include "pal_os/atomic.h"
 #include "pal_os/common.h"
 
 /* ---------------------------------------------------------------------------
@@ -34,6 +35,32 @@
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Get the semaphore backing the mutex, creating it on first use for statically initialized mutexes.
+ * @param[in] mutex Pointer to the mutex.
+ * @return Semaphore handle, or NULL if it could not be created.
+ */
+static SemaphoreHandle_t pal_mutex_get_handle(pal_mutex_t *mutex)
+{
+	SemaphoreHandle_t handle = (SemaphoreHandle_t)pal_atomic_ptr_load((void *const *)&mutex->mutex_handle, PAL_ATOMIC_ACQUIRE);
+	if (NULL == handle)
+	{
+		SemaphoreHandle_t created = mutex->is_recursive ? xSemaphoreCreateRecursiveMutex() : xSemaphoreCreateMutex();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&mutex->mutex_handle, (void **)&handle, created, PAL_ATOMIC_ACQ_REL))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its semaphore
+				vSemaphoreDelete(created);
+			}
+		}
+	}
+	return handle;
+}
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -51,6 +78,7 @@ int pal_mutex_create(pal_mutex_t *mutex, int recursive)
 		}
 		else
 		{
+			mutex->is_recursive = 0;
 			mutex->mutex_handle = xSemaphoreCreateMutex();
 		}
 		if (mutex->mutex_handle)
@@ -63,8 +91,9 @@ int pal_mutex_create(pal_mutex_t *mutex, int recursive)
 
 int pal_mutex_lock(pal_mutex_t *mutex, size_t timeout_ms)
 {
-	int ret_code = -1;
-	if (mutex)
+	int				  ret_code = -1;
+	SemaphoreHandle_t handle   = mutex ? pal_mutex_get_handle(mutex) : NULL;
+	if (handle)
 	{
 		TickType_t timeout_ticks = portMAX_DELAY;
 		if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
@@ -73,11 +102,11 @@ int pal_mutex_lock(pal_mutex_t *mutex, size_t timeout_ms)
 		}
 		if (mutex->is_recursive)
 		{
-			ret_code = pdTRUE == xSemaphoreTakeRecursive(mutex->mutex_handle, timeout_ticks) ? 0 : -1;
+			ret_code = pdTRUE == xSemaphoreTakeRecursive(handle, timeout_ticks) ? 0 : -1;
 		}
 		else
 		{
-			ret_code = pdTRUE == xSemaphoreTake(mutex->mutex_handle, timeout_ticks) ? 0 : -1;
+			ret_code = pdTRUE == xSemaphoreTake(handle, timeout_ticks) ? 0 : -1;
 		}
 	}
 	return ret_code;
@@ -86,7 +115,7 @@ int pal_mutex_lock(pal_mutex_t *mutex, size_t timeout_ms)
 int pal_mutex_unlock(pal_mutex_t *mutex)
 {
 	int ret_code = -1;
-	if (mutex)
+	if (mutex && mutex->mutex_handle)
 	{
 		if (mutex->is_recursive)
 		{
@@ -106,7 +135,8 @@ int pal_mutex_destroy(pal_mutex_t *mutex)
 	if (mutex && mutex->mutex_handle)
 	{
 		vSemaphoreDelete(mutex->mutex_handle);
-		ret_code = 0;
+		mutex->mutex_handle = NULL;
+		ret_code			= 0;
 	}
 	return ret_code;
 }
\ No newline at end of file
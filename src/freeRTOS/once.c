@@ -0,0 +1,111 @@
+/*
+ * File: once.c
+ * Description: Implementation of one-time initialization for the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/once.h"
+
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_ONCE_INIT_STATE 0				   //!< The initialization function has not been called yet
+#define PAL_ONCE_RUNNING	1				   //!< The initialization function is running
+#define PAL_ONCE_DONE		2				   //!< The initialization function has returned
+#define PAL_ONCE_DONE_BIT	((EventBits_t)1)  //!< Event bit set when the initialization function has returned
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Get the event group of the control, creating it for the first task that has to wait.
+ * @param[in] once Pointer to the once control.
+ * @return Event group handle, or NULL if it could not be created.
+ */
+static EventGroupHandle_t pal_once_get_handle(pal_once_t *once)
+{
+	EventGroupHandle_t handle = (EventGroupHandle_t)pal_atomic_ptr_load((void *const *)&once->group, PAL_ATOMIC_SEQ_CST);
+	if (NULL == handle)
+	{
+		EventGroupHandle_t created = xEventGroupCreate();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&once->group, (void **)&handle, created, PAL_ATOMIC_SEQ_CST))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its event group
+				vEventGroupDelete(created);
+			}
+		}
+	}
+	return handle;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_once_call(pal_once_t *once, pal_once_func_t func, void *arg)
+{
+	int ret_code = -1;
+	if (once && func)
+	{
+		uint32_t state = pal_atomic_u32_load(&once->state, PAL_ATOMIC_ACQUIRE);
+		if (PAL_ONCE_DONE == state)
+		{
+			ret_code = 0;
+		}
+		else if (PAL_ONCE_INIT_STATE == state &&
+				 pal_atomic_u32_compare_exchange(&once->state, &state, PAL_ONCE_RUNNING, PAL_ATOMIC_ACQUIRE))
+		{
+			func(arg);
+			// Pairs with the waiter publishing the event group before checking the state: one of the two always sees the other
+			pal_atomic_u32_store(&once->state, PAL_ONCE_DONE, PAL_ATOMIC_SEQ_CST);
+			EventGroupHandle_t group = (EventGroupHandle_t)pal_atomic_ptr_load((void *const *)&once->group, PAL_ATOMIC_SEQ_CST);
+			if (group)
+			{
+				xEventGroupSetBits(group, PAL_ONCE_DONE_BIT);
+			}
+			ret_code = 0;
+		}
+		else
+		{
+			EventGroupHandle_t group = pal_once_get_handle(once);
+			if (group)
+			{
+				if (PAL_ONCE_DONE != pal_atomic_u32_load(&once->state, PAL_ATOMIC_SEQ_CST))
+				{
+					xEventGroupWaitBits(group, PAL_ONCE_DONE_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+				}
+				ret_code = 0;
+			}
+		}
+	}
+	return ret_code;
+}
@@ -0,0 +1,148 @@
+/*
+ * File: sem.c
+ * Description: Implementation of counting semaphore functionality for the freeRTOS platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/sem.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Get the semaphore handle, creating it on first use for statically initialized semaphores.
+ * @param[in] sem Pointer to the semaphore.
+ * @return Semaphore handle, or NULL if it could not be created.
+ */
+static SemaphoreHandle_t pal_sem_get_handle(pal_sem_t *sem)
+{
+	SemaphoreHandle_t handle = (SemaphoreHandle_t)pal_atomic_ptr_load((void *const *)&sem->handle, PAL_ATOMIC_ACQUIRE);
+	if (NULL == handle)
+	{
+		SemaphoreHandle_t created = xSemaphoreCreateCounting(sem->max_count, sem->initial_count);
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&sem->handle, (void **)&handle, created, PAL_ATOMIC_ACQ_REL))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its semaphore
+				vSemaphoreDelete(created);
+			}
+		}
+	}
+	return handle;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_sem_create(pal_sem_t *sem, size_t max_count, size_t initial_count)
+{
+	int ret_code = -1;
+	if (sem && max_count && initial_count <= max_count)
+	{
+		sem->max_count	   = max_count;
+		sem->initial_count = initial_count;
+		sem->handle		   = xSemaphoreCreateCounting(max_count, initial_count);
+		ret_code		   = sem->handle ? 0 : -1;
+	}
+	return ret_code;
+}
+
+int pal_sem_take(pal_sem_t *sem, size_t timeout_ms)
+{
+	int				  ret_code = -1;
+	SemaphoreHandle_t handle   = sem ? pal_sem_get_handle(sem) : NULL;
+	if (handle)
+	{
+		TickType_t timeout_ticks = portMAX_DELAY;
+		if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+		{
+			timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+		}
+		ret_code = pdTRUE == xSemaphoreTake(handle, timeout_ticks) ? 0 : -1;
+	}
+	return ret_code;
+}
+
+int pal_sem_give(pal_sem_t *sem)
+{
+	int				  ret_code = -1;
+	SemaphoreHandle_t handle   = sem ? pal_sem_get_handle(sem) : NULL;
+	if (handle)
+	{
+		ret_code = pdTRUE == xSemaphoreGive(handle) ? 0 : -1;
+	}
+	return ret_code;
+}
+
+PAL_OS_RAM_ATTR int pal_sem_give_from_isr(pal_sem_t *sem)
+{
+	int ret_code = -1;
+	// The semaphore cannot be allocated from an ISR: a statically initialized semaphore must be used by a task first
+	if (sem && sem->handle)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		ret_code							= pdTRUE == xSemaphoreGiveFromISR(sem->handle, &xHigherPriorityTaskWoken) ? 0 : -1;
+		if (xHigherPriorityTaskWoken)
+		{
+			portYIELD_FROM_ISR();
+		}
+	}
+	return ret_code;
+}
+
+size_t pal_sem_get_count(pal_sem_t *sem)
+{
+	size_t count = 0;
+	if (sem)
+	{
+		count = sem->handle ? uxSemaphoreGetCount(sem->handle) : sem->initial_count;
+	}
+	return count;
+}
+
+int pal_sem_destroy(pal_sem_t *sem)
+{
+	int ret_code = -1;
+	if (sem)
+	{
+		if (sem->handle)
+		{
+			vSemaphoreDelete(sem->handle);
+			sem->handle = NULL;
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
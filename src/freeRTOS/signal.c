@@ -8,17 +8,34 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+#include "pal_os/atomic.h"
 #include "pal_os/common.h"
 
 /* ---------------------------------------------------------------------------
  * Type Definitions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Task blocked in pal_signal_wait_multi, linked from the waiter list for as long as it waits
+ */
+typedef struct pal_signal_waiter_s
+{
+	struct pal_signal_waiter_s	  *next;	 //!< Next waiting task
+	const pal_signal_wait_entry_t *entries;	 //!< Conditions of the wait
+	size_t						   count;	 //!< Number of entries
+	SemaphoreHandle_t			   wakeup;	 //!< Binary semaphore given when one of the signals of the entries is set
+} pal_signal_waiter_t;
 
 /* ---------------------------------------------------------------------------
  * Static Definitions
  * ---------------------------------------------------------------------------
  */
+static SemaphoreHandle_t	pal_signal_waiters_lock	 = NULL;  //!< Mutex protecting the waiter list, created on first use
+static pal_signal_waiter_t *pal_signal_waiters		 = NULL;  //!< Tasks blocked in pal_signal_wait_multi
+static size_t				pal_signal_waiters_count = 0;	  //!< Number of tasks in the waiter list, read without the lock by the setters
 
 /* ---------------------------------------------------------------------------
  * Macros
@@ -34,6 +51,119 @@
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Get the event group backing the signal, creating it on first use for statically initialized signals.
+ * @param[in] signal Pointer to the signal object.
+ * @return Event group handle, or NULL if it could not be created.
+ */
+static EventGroupHandle_t pal_signal_get_handle(pal_signal_t *signal)
+{
+	EventGroupHandle_t handle = (EventGroupHandle_t)pal_atomic_ptr_load(signal, PAL_ATOMIC_ACQUIRE);
+	if (NULL == handle)
+	{
+		EventGroupHandle_t created = xEventGroupCreate();
+		if (created)
+		{
+			void *expected = NULL;
+			if (pal_atomic_ptr_compare_exchange(signal, &expected, (void *)created, PAL_ATOMIC_ACQ_REL))
+			{
+				handle = created;
+			}
+			else
+			{
+				// Another task won the race, keep its event group
+				vEventGroupDelete(created);
+				handle = (EventGroupHandle_t)expected;
+			}
+		}
+	}
+	return handle;
+}
+
+/**
+ * @brief Get the mutex protecting the waiter list, creating it on first use.
+ * @return Mutex handle, or NULL if it could not be created.
+ */
+static SemaphoreHandle_t pal_signal_get_waiters_lock(void)
+{
+	SemaphoreHandle_t lock = (SemaphoreHandle_t)pal_atomic_ptr_load((void *const *)&pal_signal_waiters_lock, PAL_ATOMIC_ACQUIRE);
+	if (NULL == lock)
+	{
+		SemaphoreHandle_t created = xSemaphoreCreateMutex();
+		if (created)
+		{
+			if (pal_atomic_ptr_compare_exchange((void **)&pal_signal_waiters_lock, (void **)&lock, created, PAL_ATOMIC_ACQ_REL))
+			{
+				lock = created;
+			}
+			else
+			{
+				// Another task won the race, keep its mutex
+				vSemaphoreDelete(created);
+			}
+		}
+	}
+	return lock;
+}
+
+/**
+ * @brief Wake the tasks of pal_signal_wait_multi waiting on a signal, so that they check their entries again.
+ * @param[in] handle Event group of the signal whose bits were set.
+ */
+static void pal_signal_wake_waiters(EventGroupHandle_t handle)
+{
+	// Pairs with the registration of pal_signal_wait_multi: either the waiter is seen here, or it sees the bits already set
+	if (pal_atomic_size_load(&pal_signal_waiters_count, PAL_ATOMIC_SEQ_CST))
+	{
+		SemaphoreHandle_t lock = pal_signal_get_waiters_lock();
+		if (lock && pdTRUE == xSemaphoreTake(lock, portMAX_DELAY))
+		{
+			for (pal_signal_waiter_t *waiter = pal_signal_waiters; waiter; waiter = waiter->next)
+			{
+				for (size_t i = 0; i < waiter->count; i++)
+				{
+					if ((EventGroupHandle_t)*waiter->entries[i].signal == handle)
+					{
+						xSemaphoreGive(waiter->wakeup);
+						break;
+					}
+				}
+			}
+			xSemaphoreGive(lock);
+		}
+	}
+}
+
+/**
+ * @brief Check the entries of a pal_signal_wait_multi call once, without blocking.
+ * @param[in,out] entries Conditions to check. The received signals are stored in the entry that is satisfied.
+ * @param[in] count Number of entries.
+ * @param[out] index Index of the satisfied entry.
+ * @return Non-zero if an entry is satisfied.
+ */
+static int pal_signal_check_entries(pal_signal_wait_entry_t *entries, size_t count, size_t *index)
+{
+	int satisfied = 0;
+	for (size_t i = 0; i < count && !satisfied; i++)
+	{
+		pal_signal_wait_entry_t *entry = &entries[i];
+		EventBits_t				 bits  = xEventGroupWaitBits((EventGroupHandle_t)*entry->signal, entry->mask, entry->clear_mask, entry->wait_all, 0);
+		if ((entry->wait_all && (entry->mask == (bits & entry->mask))) || (!entry->wait_all && (bits & entry->mask)))
+		{
+			entry->received_signals = bits & entry->mask;
+			*index					= i;
+			satisfied				= 1;
+		}
+	}
+	return satisfied;
+}
+
+/**
+ * @brief Set the bits of a signal on behalf of an ISR, from the timer service task.
+ * @param[in] signal Pointer to the signal object.
+ * @param[in] mask Bitmask of signals to set.
+ */
+static void pal_signal_set_deferred(void *signal, uint32_t mask) { pal_signal_set((pal_signal_t *)signal, mask); }
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -53,7 +183,8 @@ int pal_signal_create(pal_signal_t *signal)
 pal_signal_ret_code_t pal_signal_wait(pal_signal_t *signal, size_t mask, size_t *received_signals, int clear_mask, int wait_all, size_t timeout_ms)
 {
 	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
-	if (signal && received_signals)
+	EventGroupHandle_t	  handle   = signal ? pal_signal_get_handle(signal) : NULL;
+	if (handle && received_signals)
 	{
 		TickType_t	timeout_ticks = portMAX_DELAY;
 		EventBits_t bits		  = 0;
@@ -61,7 +192,7 @@ pal_signal_ret_code_t pal_signal_wait(pal_signal_t *signal, size_t mask, size_t
 		{
 			timeout_ticks = pdMS_TO_TICKS(timeout_ms);
 		}
-		bits = xEventGroupWaitBits((EventGroupHandle_t)*signal, mask, clear_mask, wait_all, timeout_ticks);
+		bits = xEventGroupWaitBits(handle, mask, clear_mask, wait_all, timeout_ticks);
 		if ((wait_all && (bits == mask)) || (!wait_all && (bits & mask)))
 		{
 			ret_code = PAL_SIGNAL_SUCCESS;
@@ -75,13 +206,101 @@ pal_signal_ret_code_t pal_signal_wait(pal_signal_t *signal, size_t mask, size_t
 	return ret_code;
 }
 
+pal_signal_ret_code_t pal_signal_wait_multi(pal_signal_wait_entry_t *entries, size_t count, size_t *index, size_t timeout_ms)
+{
+	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
+	size_t				  valid	   = 0;
+	while (entries && index && valid < count && entries[valid].signal && pal_signal_get_handle(entries[valid].signal))
+	{
+		valid++;
+	}
+	SemaphoreHandle_t lock = valid && valid == count ? pal_signal_get_waiters_lock() : NULL;
+	if (lock)
+	{
+		ret_code = pal_signal_check_entries(entries, count, index) ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
+	}
+	if (PAL_SIGNAL_TIMEOUT == ret_code && PAL_OS_NO_TIMEOUT != timeout_ms)
+	{
+		// A task cannot block on several event groups at once: it blocks on its own semaphore, given by every set of its signals
+		pal_signal_waiter_t waiter = {NULL, entries, count, xSemaphoreCreateBinary()};
+		if (waiter.wakeup)
+		{
+			TickType_t start		 = xTaskGetTickCount();
+			TickType_t timeout_ticks = portMAX_DELAY;
+			int		   waiting		 = 1;
+			if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+			{
+				timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+			}
+			xSemaphoreTake(lock, portMAX_DELAY);
+			waiter.next		   = pal_signal_waiters;
+			pal_signal_waiters = &waiter;
+			pal_atomic_size_fetch_add(&pal_signal_waiters_count, 1, PAL_ATOMIC_SEQ_CST);
+			xSemaphoreGive(lock);
+			while (waiting)
+			{
+				if (pal_signal_check_entries(entries, count, index))
+				{
+					ret_code = PAL_SIGNAL_SUCCESS;
+					waiting	 = 0;
+				}
+				else if (portMAX_DELAY == timeout_ticks)
+				{
+					xSemaphoreTake(waiter.wakeup, portMAX_DELAY);
+				}
+				else
+				{
+					TickType_t elapsed = xTaskGetTickCount() - start;
+					waiting			   = elapsed < timeout_ticks && pdTRUE == xSemaphoreTake(waiter.wakeup, timeout_ticks - elapsed);
+				}
+			}
+			xSemaphoreTake(lock, portMAX_DELAY);
+			pal_signal_waiter_t **link = &pal_signal_waiters;
+			while (*link != &waiter)
+			{
+				link = &(*link)->next;
+			}
+			*link = waiter.next;
+			pal_atomic_size_fetch_sub(&pal_signal_waiters_count, 1, PAL_ATOMIC_SEQ_CST);
+			xSemaphoreGive(lock);
+			vSemaphoreDelete(waiter.wakeup);
+		}
+		else
+		{
+			ret_code = PAL_SIGNAL_FAILURE;
+		}
+	}
+	return ret_code;
+}
+
+pal_signal_ret_code_t pal_signal_sync(pal_signal_t *signal, size_t set_mask, size_t wait_mask, size_t timeout_ms)
+{
+	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
+	EventGroupHandle_t	  handle   = signal ? pal_signal_get_handle(signal) : NULL;
+	if (handle && wait_mask)
+	{
+		TickType_t timeout_ticks = portMAX_DELAY;
+		if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+		{
+			timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+		}
+		EventBits_t bits = xEventGroupSync(handle, set_mask, wait_mask, timeout_ticks);
+		ret_code		 = (wait_mask == (bits & wait_mask)) ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
+		// The bits are set inside the rendezvous, the tasks waiting on several signals only learn about them once it returns
+		pal_signal_wake_waiters(handle);
+	}
+	return ret_code;
+}
+
 int pal_signal_set(pal_signal_t *signal, size_t mask)
 {
-	int ret_code = -1;
-	if (signal)
+	int				   ret_code = -1;
+	EventGroupHandle_t handle	= signal ? pal_signal_get_handle(signal) : NULL;
+	if (handle)
 	{
-		if (pdPASS == xEventGroupSetBits((EventGroupHandle_t)*signal, mask))
+		if (pdPASS == xEventGroupSetBits(handle, mask))
 		{
+			pal_signal_wake_waiters(handle);
 			ret_code = 0;
 		}
 	}
@@ -91,10 +310,12 @@ int pal_signal_set(pal_signal_t *signal, size_t mask)
 int pal_signal_set_from_isr(pal_signal_t *signal, size_t mask)
 {
 	int ret_code = -1;
-	if (signal)
+	// The event group cannot be allocated from an ISR: a statically initialized signal must be used by a task first
+	if (signal && *signal)
 	{
 		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-		if (pdPASS == xEventGroupSetBitsFromISR((EventGroupHandle_t)*signal, mask, &xHigherPriorityTaskWoken))
+		// Like xEventGroupSetBitsFromISR the bits are set by the timer service task, which also wakes the tasks waiting on several signals
+		if (pdPASS == xTimerPendFunctionCallFromISR(pal_signal_set_deferred, signal, (uint32_t)mask, &xHigherPriorityTaskWoken))
 		{
 			if (xHigherPriorityTaskWoken)
 			{
@@ -108,20 +329,40 @@ int pal_signal_set_from_isr(pal_signal_t *signal, size_t mask)
 
 int pal_signal_clear(pal_signal_t *signal, size_t mask)
 {
-	int ret_code = -1;
-	if (signal)
+	int				   ret_code = -1;
+	EventGroupHandle_t handle	= signal ? pal_signal_get_handle(signal) : NULL;
+	if (handle)
 	{
-		ret_code = (pdPASS == xEventGroupClearBits((EventGroupHandle_t)*signal, mask)) ? 0 : -1;
+		ret_code = (pdPASS == xEventGroupClearBits(handle, mask)) ? 0 : -1;
 	}
 	return ret_code;
 }
 
+int pal_signal_enable_stats(pal_signal_t *signal, pal_signal_stats_t *stats)
+{
+	// Waiters are woken inside the kernel event group, where the handoff cannot be observed
+	(void)signal;
+	(void)stats;
+	return -1;
+}
+
+int pal_signal_get_stats(pal_signal_t *signal, pal_signal_stats_t *stats)
+{
+	(void)signal;
+	(void)stats;
+	return -1;
+}
+
 int pal_signal_destroy(pal_signal_t *signal)
 {
 	int ret_code = -1;
 	if (signal)
 	{
-		vEventGroupDelete((EventGroupHandle_t)*signal);
+		if (*signal)
+		{
+			vEventGroupDelete((EventGroupHandle_t)*signal);
+			*signal = NULL;
+		}
 		ret_code = 0;
 	}
 	return ret_code;
@@ -8,6 +8,8 @@
 
 #include <string.h>
 
+#include "pal_os/common.h"
+
 /* ---------------------------------------------------------------------------
  * Type Definitions
  * ---------------------------------------------------------------------------
@@ -33,6 +35,30 @@
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Convert a pal notification action to the freeRTOS one.
+ * @param action pal notification action.
+ * @return freeRTOS notification action.
+ */
+static eNotifyAction pal_thread_convert_notify_action(pal_thread_notify_action_t action)
+{
+	eNotifyAction freertos_action = eNoAction;
+	switch (action)
+	{
+		case PAL_THREAD_NOTIFY_SET_BITS:
+			freertos_action = eSetBits;
+			break;
+		case PAL_THREAD_NOTIFY_INCREMENT:
+			freertos_action = eIncrement;
+			break;
+		case PAL_THREAD_NOTIFY_OVERWRITE:
+			freertos_action = eSetValueWithOverwrite;
+			break;
+		default:
+			break;
+	}
+	return freertos_action;
+}
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -127,6 +153,44 @@ size_t pal_thread_get_stack_watermark(pal_thread_t *const thread)
 	return stack_watermark;
 }
 
+int pal_thread_notify(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action)
+{
+	int ret_code = -1;
+	if (thread && thread->thread_handle)
+	{
+		ret_code = pdPASS == xTaskNotify(thread->thread_handle, value, pal_thread_convert_notify_action(action)) ? 0 : -1;
+	}
+	return ret_code;
+}
+
+PAL_OS_RAM_ATTR int pal_thread_notify_from_isr(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action)
+{
+	int ret_code = -1;
+	if (thread && thread->thread_handle)
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+		if (pdPASS == xTaskNotifyFromISR(thread->thread_handle, value, pal_thread_convert_notify_action(action), &xHigherPriorityTaskWoken))
+		{
+			ret_code = 0;
+		}
+		if (xHigherPriorityTaskWoken)
+		{
+			portYIELD_FROM_ISR();
+		}
+	}
+	return ret_code;
+}
+
+int pal_thread_notify_wait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, size_t timeout_ms)
+{
+	TickType_t timeout_ticks = portMAX_DELAY;
+	if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+	{
+		timeout_ticks = pdMS_TO_TICKS(timeout_ms);
+	}
+	return pdTRUE == xTaskNotifyWait(clear_on_entry, clear_on_exit, value, timeout_ticks) ? 0 : -1;
+}
+
 void pal_thread_free(pal_thread_t *thread)
 {
 	if (thread && PAL_THREAD_STATE_TERMINATED == thread->state)
@@ -39,6 +39,16 @@
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Convert a period in microseconds to the nearest number of ticks.
+ * @param[in] period_us Period in microseconds.
+ * @return Period in ticks, at least one.
+ */
+static TickType_t pal_timer_us_to_ticks(size_t period_us)
+{
+	uint64_t ticks = ((uint64_t)period_us * configTICK_RATE_HZ + 500000ULL) / 1000000ULL;
+	return ticks ? (TickType_t)ticks : 1;
+}
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -151,6 +161,25 @@ PAL_OS_RAM_ATTR int pal_timer_restart_from_isr(pal_timer_t *timer)
 	return ret_code;
 }
 
+int pal_timer_create_us(pal_timer_t *timer, const char *name, pal_timer_type_t type, size_t period_us, pal_timer_callback_t callback, int auto_start, void *arg)
+{
+	int ret_code = -1;
+	if (timer && callback && period_us)
+	{
+		BaseType_t auto_reload = (PAL_TIMER_TYPE_PERIODIC == type) ? pdTRUE : pdFALSE;
+		*timer				   = (pal_timer_t *)xTimerCreate(name, pal_timer_us_to_ticks(period_us), auto_reload, arg, (TimerCallbackFunction_t)callback);
+		if (*timer)
+		{
+			ret_code = 0;
+			if (auto_start)
+			{
+				xTimerStart((TimerHandle_t)*timer, portMAX_DELAY);
+			}
+		}
+	}
+	return ret_code;
+}
+
 int pal_timer_change_period(pal_timer_t *timer, size_t new_period)
 {
 	int ret_code = -1;
@@ -180,6 +209,88 @@ PAL_OS_RAM_ATTR int pal_timer_change_period_from_isr(pal_timer_t *timer, size_t
 	return ret_code;
 }
 
+int pal_timer_change_period_us(pal_timer_t *timer, size_t new_period_us)
+{
+	int ret_code = -1;
+	if (timer && new_period_us)
+	{
+		xTimerChangePeriod((TimerHandle_t)timer, pal_timer_us_to_ticks(new_period_us), portMAX_DELAY);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+size_t pal_timer_get_resolution_us(void) { return 1000000UL / configTICK_RATE_HZ; }
+
+int pal_timer_set_backend(pal_timer_t *timer, pal_timer_backend_t backend)
+{
+	int ret_code = -1;
+	// The kernel timer service schedules every timer, the backend only matters on Linux
+	if (timer && (PAL_TIMER_BACKEND_HEAP == backend || PAL_TIMER_BACKEND_WHEEL == backend))
+	{
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_timer_set_slack(pal_timer_t *timer, size_t slack_ms)
+{
+	// The kernel timer service wakes up at every tick with an expired timer, there is nothing to coalesce
+	(void)slack_ms;
+	return timer ? 0 : -1;
+}
+
+int pal_timer_set_spin(pal_timer_t *timer, size_t spin_us)
+{
+	// Expiries are tick aligned and the kernel timer service wakes up on the tick interrupt, there is no wakeup latency to hide
+	(void)spin_us;
+	return timer ? 0 : -1;
+}
+
+int pal_timer_set_overrun_policy(pal_timer_t *timer, pal_timer_overrun_policy_t policy)
+{
+	int ret_code = -1;
+	// Auto-reload timers are rescheduled from their expiry and the kernel timer service runs every missed period
+	if (timer && PAL_TIMER_OVERRUN_CATCH_UP == policy)
+	{
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+size_t pal_timer_get_overruns(pal_timer_t *timer)
+{
+	(void)timer;
+	return 0;
+}
+
+int pal_timer_set_dispatch(pal_timer_t *timer, pal_timer_dispatch_t dispatch, pal_queue_t *queue, int concurrent)
+{
+	int ret_code = -1;
+	(void)queue;
+	(void)concurrent;
+	// The kernel timer service task runs every callback
+	if (timer && PAL_TIMER_DISPATCH_SERVICE == dispatch)
+	{
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_timer_run_dispatched(pal_timer_t *timer)
+{
+	(void)timer;
+	return -1;
+}
+
+int pal_timer_set_shards(size_t count)
+{
+	// Every timer is run by the single kernel timer service task
+	return 1 == count ? 0 : -1;
+}
+
+int pal_timer_set_shard(pal_timer_t *timer, size_t shard) { return timer && 0 == shard ? 0 : -1; }
+
 int pal_is_timer_active(pal_timer_t *timer)
 {
 	int ret_code = 0;
@@ -0,0 +1,89 @@
+/*
+ * File: barrier.c
+ * Description: Implementation of barrier functionality for the Linux platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/barrier.h"
+
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_barrier_create(pal_barrier_t *barrier, size_t count)
+{
+	int ret_code = -1;
+	if (barrier && count && count <= UINT32_MAX)
+	{
+		barrier->count		= (uint32_t)count;
+		barrier->arrived	= 0;
+		barrier->generation = 0;
+		ret_code			= 0;
+	}
+	return ret_code;
+}
+
+int pal_barrier_wait(pal_barrier_t *barrier)
+{
+	int ret_code = -1;
+	if (barrier && barrier->count)
+	{
+		// The generation cannot move before this thread arrives, so it identifies the round being joined
+		uint32_t generation = pal_atomic_u32_load(&barrier->generation, PAL_ATOMIC_ACQUIRE);
+		if (barrier->count - 1 == pal_atomic_u32_fetch_add(&barrier->arrived, 1, PAL_ATOMIC_ACQ_REL))
+		{
+			// Threads of the next round can only arrive after observing the new generation, so the reset is ordered before them
+			pal_atomic_u32_store(&barrier->arrived, 0, PAL_ATOMIC_RELAXED);
+			pal_atomic_u32_store(&barrier->generation, generation + 1, PAL_ATOMIC_RELEASE);
+			pal_futex_wake(&barrier->generation, PAL_FUTEX_WAKE_ALL);
+			ret_code = PAL_BARRIER_SERIAL_THREAD;
+		}
+		else
+		{
+			while (generation == pal_atomic_u32_load(&barrier->generation, PAL_ATOMIC_ACQUIRE))
+			{
+				pal_futex_wait(&barrier->generation, generation, NULL);
+			}
+			ret_code = 0;
+		}
+	}
+	return ret_code;
+}
+
+int pal_barrier_destroy(pal_barrier_t *barrier)
+{
+	int ret_code = -1;
+	if (barrier)
+	{
+		ret_code = 0 == pal_atomic_u32_load(&barrier->arrived, PAL_ATOMIC_RELAXED) ? 0 : -1;
+	}
+	return ret_code;
+}
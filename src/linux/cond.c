@@ -0,0 +1,124 @@
+/*
+ * File: cond.c
+ * Description: Implementation of condition variable functionality for the Linux platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/cond.h"
+
+#include <errno.h>
+#include <time.h>
+
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Wake waiters after bumping the sequence number.
+ * @param[in] cond Pointer to the condition variable.
+ * @param[in] count Number of waiters to wake.
+ */
+static void pal_cond_wake(pal_cond_t *cond, int count)
+{
+	pal_atomic_u32_fetch_add(&cond->seq, 1, PAL_ATOMIC_SEQ_CST);
+	if (0 != pal_atomic_u32_load(&cond->waiters, PAL_ATOMIC_SEQ_CST))
+	{
+		pal_futex_wake(&cond->seq, count);
+	}
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_cond_create(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		cond->seq	  = 0;
+		cond->waiters = 0;
+		ret_code	  = 0;
+	}
+	return ret_code;
+}
+
+int pal_cond_wait(pal_cond_t *cond, pal_mutex_t *mutex) { return pal_cond_timedwait(cond, mutex, PAL_OS_INFINITE_TIMEOUT); }
+
+int pal_cond_timedwait(pal_cond_t *cond, pal_mutex_t *mutex, size_t timeout_ms)
+{
+	int ret_code = -1;
+	// Unlocking a recursive mutex held more than once only drops one level, the waiter would sleep still owning it
+	if (cond && mutex && !(mutex->recursive && mutex->depth))
+	{
+		struct timespec	 ts;
+		struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+		// Register as waiter and sample the sequence while still holding the mutex: a signal issued after the unlock changes
+		// the sequence and makes the futex wait return immediately, so no wakeup can be lost
+		pal_atomic_u32_fetch_add(&cond->waiters, 1, PAL_ATOMIC_SEQ_CST);
+		uint32_t seq = pal_atomic_u32_load(&cond->seq, PAL_ATOMIC_SEQ_CST);
+		if (0 == pal_mutex_unlock(mutex))
+		{
+			ret_code = ETIMEDOUT == pal_futex_wait(&cond->seq, seq, deadline) ? -1 : 0;
+			pal_mutex_lock(mutex, PAL_OS_INFINITE_TIMEOUT);
+		}
+		pal_atomic_u32_fetch_sub(&cond->waiters, 1, PAL_ATOMIC_RELAXED);
+	}
+	return ret_code;
+}
+
+int pal_cond_signal(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		pal_cond_wake(cond, 1);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_cond_broadcast(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		pal_cond_wake(cond, PAL_FUTEX_WAKE_ALL);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_cond_destroy(pal_cond_t *cond)
+{
+	int ret_code = -1;
+	if (cond)
+	{
+		ret_code = 0 == pal_atomic_u32_load(&cond->waiters, PAL_ATOMIC_RELAXED) ? 0 : -1;
+	}
+	return ret_code;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ============================
+// Includes
+// ============================
+#include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pal_os/common.h"
+
+// ============================
+// Macros and Constants
+// ============================
+#define PAL_FUTEX_WAKE_ALL INT_MAX	//!< Wake every thread blocked on a futex word
+
+// ============================
+// Type Definitions
+// ============================
+
+// ============================
+// Function Declarations
+// ============================
+/**
+ * @brief Compute the absolute CLOCK_MONOTONIC deadline for a relative timeout.
+ *
+ * @param[in] timeout_ms Relative timeout in milliseconds.
+ * @param[out] deadline Absolute deadline.
+ * @return Pointer to deadline, or NULL for PAL_OS_INFINITE_TIMEOUT.
+ */
+static inline struct timespec *pal_futex_deadline(size_t timeout_ms, struct timespec *deadline)
+{
+	struct timespec *ret = NULL;
+	if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+	{
+		clock_gettime(CLOCK_MONOTONIC, deadline);
+		deadline->tv_sec += timeout_ms / 1000;
+		deadline->tv_nsec += (timeout_ms % 1000) * 1000000;
+		if (deadline->tv_nsec >= 1000000000)
+		{
+			deadline->tv_sec++;
+			deadline->tv_nsec -= 1000000000;
+		}
+		ret = deadline;
+	}
+	return ret;
+}
+
+/**
+ * @brief Block while *word still holds expected.
+ *
+ * @param[in] word Futex word.
+ * @param[in] expected Value the word must hold for the caller to sleep.
+ * @param[in] deadline Absolute CLOCK_MONOTONIC deadline, or NULL to wait forever.
+ * @return 0 when woken, ETIMEDOUT on timeout, EAGAIN if the word changed, EINTR if interrupted.
+ * @note Wakeups may be spurious: callers must re-check their condition.
+ */
+static inline int pal_futex_wait(uint32_t *word, uint32_t expected, const struct timespec *deadline)
+{
+	int ret = 0;
+	if (0 != syscall(SYS_futex, word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG, expected, deadline, NULL, FUTEX_BITSET_MATCH_ANY))
+	{
+		ret = errno;
+	}
+	return ret;
+}
+
+/**
+ * @brief Wake up to count threads blocked on word.
+ *
+ * @param[in] word Futex word.
+ * @param[in] count Maximum number of threads to wake, PAL_FUTEX_WAKE_ALL for all of them.
+ */
+static inline void pal_futex_wake(uint32_t *word, int count) { syscall(SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG, count, NULL, NULL, 0); }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,99 @@
+/*
+ * File: latch.c
+ * Description: Implementation of countdown latch functionality for the Linux platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/latch.h"
+
+#include <errno.h>
+#include <time.h>
+
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_latch_create(pal_latch_t *latch, size_t count)
+{
+	int ret_code = -1;
+	if (latch && count <= UINT32_MAX)
+	{
+		latch->count = (uint32_t)count;
+		ret_code	 = 0;
+	}
+	return ret_code;
+}
+
+int pal_latch_count_down(pal_latch_t *latch)
+{
+	int ret_code = -1;
+	if (latch)
+	{
+		uint32_t count = pal_atomic_u32_load(&latch->count, PAL_ATOMIC_RELAXED);
+		while (count)
+		{
+			if (pal_atomic_u32_compare_exchange(&latch->count, &count, count - 1, PAL_ATOMIC_RELEASE))
+			{
+				if (1 == count)
+				{
+					pal_futex_wake(&latch->count, PAL_FUTEX_WAKE_ALL);
+				}
+				ret_code = 0;
+				break;
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_latch_wait(pal_latch_t *latch, size_t timeout_ms)
+{
+	int ret_code = -1;
+	if (latch)
+	{
+		struct timespec	 ts;
+		struct timespec *deadline = NULL;
+		uint32_t		 count	  = pal_atomic_u32_load(&latch->count, PAL_ATOMIC_ACQUIRE);
+		if (count && PAL_OS_NO_TIMEOUT != timeout_ms)
+		{
+			deadline = pal_futex_deadline(timeout_ms, &ts);
+			while (count && ETIMEDOUT != pal_futex_wait(&latch->count, count, deadline))
+			{
+				count = pal_atomic_u32_load(&latch->count, PAL_ATOMIC_ACQUIRE);
+			}
+			count = pal_atomic_u32_load(&latch->count, PAL_ATOMIC_ACQUIRE);
+		}
+		ret_code = 0 == count ? 0 : -1;
+	}
+	return ret_code;
+}
+
+int pal_latch_destroy(pal_latch_t *latch) { return latch ? 0 : -1; }
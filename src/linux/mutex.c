@@ -7,11 +7,13 @@
 #include "pal_os/mutex.h"
 
 #include <errno.h>
-#include <malloc.h>
 #include <string.h>
 #include <time.h>
 
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
 #include "pal_os/common.h"
+#include "thread_priv.h"
 /* ---------------------------------------------------------------------------
  * Type Definitions
  * ---------------------------------------------------------------------------
@@ -31,11 +33,136 @@
  * Constants
  * ---------------------------------------------------------------------------
  */
+#define PAL_MUTEX_UNLOCKED	0  //!< Nobody holds the mutex
+#define PAL_MUTEX_LOCKED	1  //!< The mutex is held and nobody waits for it
+#define PAL_MUTEX_CONTENDED 2  //!< The mutex is held and other threads may be sleeping on it
+
+#define PAL_MUTEX_OWNER_MASK 0x7FFFFFFFu  //!< Recursive mutexes: bits of the futex word holding the owner thread id
+#define PAL_MUTEX_WAITERS	 0x80000000u  //!< Recursive mutexes: other threads may be sleeping on the futex word
 
 /* ---------------------------------------------------------------------------
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Contended path of pal_mutex_lock: mark the mutex as contended and sleep on the futex word.
+ * @param[in] mutex Mutex to lock.
+ * @param[in] state Last observed value of the futex word.
+ * @param[in] timeout_ms Timeout in milliseconds, or PAL_OS_INFINITE_TIMEOUT.
+ * @return 0 once the mutex is held, or -1 on timeout.
+ */
+static int pal_mutex_lock_slow(pal_mutex_t *mutex, uint32_t state, size_t timeout_ms)
+{
+	int				 ret_code = 0;
+	struct timespec	 ts;
+	struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+	if (PAL_MUTEX_CONTENDED != state)
+	{
+		state = pal_atomic_u32_exchange(&mutex->state, PAL_MUTEX_CONTENDED, PAL_ATOMIC_ACQUIRE);
+	}
+	while (PAL_MUTEX_UNLOCKED != state)
+	{
+		if (ETIMEDOUT == pal_futex_wait(&mutex->state, PAL_MUTEX_CONTENDED, deadline))
+		{
+			ret_code = -1;
+			break;
+		}
+		state = pal_atomic_u32_exchange(&mutex->state, PAL_MUTEX_CONTENDED, PAL_ATOMIC_ACQUIRE);
+	}
+	return ret_code;
+}
+
+/**
+ * @brief Release the futex word and wake one sleeper if the mutex was contended.
+ * @param[in] mutex Mutex to release.
+ */
+static void pal_mutex_release(pal_mutex_t *mutex)
+{
+	if (PAL_MUTEX_LOCKED != pal_atomic_u32_fetch_sub(&mutex->state, 1, PAL_ATOMIC_RELEASE))
+	{
+		pal_atomic_u32_store(&mutex->state, PAL_MUTEX_UNLOCKED, PAL_ATOMIC_RELEASE);
+		pal_futex_wake(&mutex->state, 1);
+	}
+}
+
+/**
+ * @brief Lock a recursive mutex: a single CAS of the thread id on first acquisition, a plain increment on re-entry.
+ * @param[in] mutex Mutex to lock.
+ * @param[in] timeout_ms Timeout in milliseconds, PAL_OS_NO_TIMEOUT or PAL_OS_INFINITE_TIMEOUT.
+ * @return 0 once the mutex is held, or -1 on timeout.
+ */
+static int pal_mutex_lock_recursive(pal_mutex_t *mutex, size_t timeout_ms)
+{
+	int		 ret_code = -1;
+	uint32_t self	  = pal_thread_get_self_id();
+	uint32_t state	  = pal_atomic_u32_load(&mutex->state, PAL_ATOMIC_RELAXED);
+	if (self == (state & PAL_MUTEX_OWNER_MASK))
+	{
+		// Only the owner can store its own id, so the relaxed load cannot be stale for this thread
+		mutex->depth++;
+		ret_code = 0;
+	}
+	else if (0 == state && pal_atomic_u32_compare_exchange(&mutex->state, &state, self, PAL_ATOMIC_ACQUIRE))
+	{
+		ret_code = 0;
+	}
+	else if (PAL_OS_NO_TIMEOUT != timeout_ms)
+	{
+		struct timespec	 ts;
+		struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+		while (0 != ret_code)
+		{
+			if (0 == state)
+			{
+				// Other threads may still be sleeping: take the lock with the waiters flag so the release wakes them
+				if (pal_atomic_u32_compare_exchange(&mutex->state, &state, self | PAL_MUTEX_WAITERS, PAL_ATOMIC_ACQUIRE))
+				{
+					ret_code = 0;
+				}
+			}
+			else if (0 == (state & PAL_MUTEX_WAITERS))
+			{
+				// On failure the owner changed or released the mutex, and the new value is retried
+				if (pal_atomic_u32_compare_exchange(&mutex->state, &state, state | PAL_MUTEX_WAITERS, PAL_ATOMIC_RELAXED))
+				{
+					state |= PAL_MUTEX_WAITERS;
+				}
+			}
+			else if (ETIMEDOUT == pal_futex_wait(&mutex->state, state, deadline))
+			{
+				break;
+			}
+			else
+			{
+				state = pal_atomic_u32_load(&mutex->state, PAL_ATOMIC_RELAXED);
+			}
+		}
+	}
+	return ret_code;
+}
+
+/**
+ * @brief Unlock a recursive mutex held by the calling thread.
+ * @param[in] mutex Mutex to unlock.
+ * @return 0 on success, or -1 if the calling thread does not own the mutex.
+ */
+static int pal_mutex_unlock_recursive(pal_mutex_t *mutex)
+{
+	int ret_code = -1;
+	if (pal_thread_get_self_id() == (pal_atomic_u32_load(&mutex->state, PAL_ATOMIC_RELAXED) & PAL_MUTEX_OWNER_MASK))
+	{
+		if (mutex->depth)
+		{
+			mutex->depth--;
+		}
+		else if (PAL_MUTEX_WAITERS & pal_atomic_u32_exchange(&mutex->state, 0, PAL_ATOMIC_RELEASE))
+		{
+			pal_futex_wake(&mutex->state, 1);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -46,16 +173,11 @@ int pal_mutex_create(pal_mutex_t *mutex, int recursive)
 	int ret_code = -1;
 	if (mutex)
 	{
-		pthread_mutexattr_t attr;
-		pthread_mutexattr_init(&attr);
-		if (recursive)
-		{
-			pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-		}
-		pthread_mutex_init(&mutex->mutex, &attr);
-		pthread_mutexattr_destroy(&attr);
-		mutex->created = true;
-		ret_code	   = 0;
+		mutex->state	 = PAL_MUTEX_UNLOCKED;
+		mutex->depth	 = 0;
+		mutex->recursive = recursive ? true : false;
+		mutex->created	 = true;
+		ret_code		 = 0;
 	}
 	return ret_code;
 }
@@ -65,25 +187,21 @@ int pal_mutex_lock(pal_mutex_t *mutex, size_t timeout_ms)
 	int ret_code = -1;
 	if (mutex)
 	{
-		switch (timeout_ms)
+		if (mutex->recursive)
 		{
-			case PAL_OS_NO_TIMEOUT:
-				ret_code = 0 == pthread_mutex_trylock(&mutex->mutex) ? 0 : -1;
-				break;
-			case PAL_OS_INFINITE_TIMEOUT:
-				ret_code = 0 == pthread_mutex_lock(&mutex->mutex) ? 0 : -1;
-				break;
-			default:
+			ret_code = pal_mutex_lock_recursive(mutex, timeout_ms);
+		}
+		else
+		{
+			uint32_t state = PAL_MUTEX_UNLOCKED;
+			if (pal_atomic_u32_compare_exchange(&mutex->state, &state, PAL_MUTEX_LOCKED, PAL_ATOMIC_ACQUIRE))
 			{
-				struct timespec timeout = {0};
-				clock_gettime(CLOCK_REALTIME, &timeout);
-				timeout.tv_sec += timeout_ms / 1000;
-				timeout.tv_nsec += (timeout_ms % 1000) * 1000000;
-				timeout.tv_sec += timeout.tv_nsec / 1000000000;
-				timeout.tv_nsec = timeout.tv_nsec % 1000000000;
-				ret_code		= 0 == pthread_mutex_timedlock(&mutex->mutex, &timeout) ? 0 : -1;
+				ret_code = 0;
+			}
+			else if (PAL_OS_NO_TIMEOUT != timeout_ms)
+			{
+				ret_code = pal_mutex_lock_slow(mutex, state, timeout_ms);
 			}
-			break;
 		}
 	}
 	return ret_code;
@@ -94,7 +212,15 @@ int pal_mutex_unlock(pal_mutex_t *mutex)
 	int ret_code = -1;
 	if (mutex)
 	{
-		ret_code = 0 == pthread_mutex_unlock(&mutex->mutex) ? 0 : -1;
+		if (mutex->recursive)
+		{
+			ret_code = pal_mutex_unlock_recursive(mutex);
+		}
+		else if (PAL_MUTEX_UNLOCKED != pal_atomic_u32_load(&mutex->state, PAL_ATOMIC_RELAXED))
+		{
+			pal_mutex_release(mutex);
+			ret_code = 0;
+		}
 	}
 	return ret_code;
 }
@@ -104,7 +230,6 @@ int pal_mutex_destroy(pal_mutex_t *mutex)
 	int ret_code = -1;
 	if (mutex && mutex->created)
 	{
-		pthread_mutex_destroy(&mutex->mutex);
 		mutex->created = 0;
 		ret_code	   = 0;
 	}
@@ -0,0 +1,77 @@
+/*
+ * File: once.c
+ * Description: Implementation of one-time initialization for the Linux platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/once.h"
+
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+#define PAL_ONCE_INIT_STATE 0  //!< The initialization function has not been called yet
+#define PAL_ONCE_RUNNING	1  //!< The initialization function is running, nobody is waiting
+#define PAL_ONCE_WAITING	2  //!< The initialization function is running and at least one thread is waiting
+#define PAL_ONCE_DONE		3  //!< The initialization function has returned
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_once_call(pal_once_t *once, pal_once_func_t func, void *arg)
+{
+	int ret_code = -1;
+	if (once && func)
+	{
+		uint32_t state = pal_atomic_u32_load(&once->state, PAL_ATOMIC_ACQUIRE);
+		if (PAL_ONCE_DONE != state)
+		{
+			if (PAL_ONCE_INIT_STATE == state &&
+				pal_atomic_u32_compare_exchange(&once->state, &state, PAL_ONCE_RUNNING, PAL_ATOMIC_ACQUIRE))
+			{
+				func(arg);
+				if (PAL_ONCE_WAITING == pal_atomic_u32_exchange(&once->state, PAL_ONCE_DONE, PAL_ATOMIC_RELEASE))
+				{
+					pal_futex_wake(&once->state, PAL_FUTEX_WAKE_ALL);
+				}
+				state = PAL_ONCE_DONE;
+			}
+			while (PAL_ONCE_DONE != state)
+			{
+				// Mark the control as waited on, so the running thread knows it has to enter the kernel
+				if (PAL_ONCE_WAITING == state ||
+					pal_atomic_u32_compare_exchange(&once->state, &state, PAL_ONCE_WAITING, PAL_ATOMIC_ACQUIRE))
+				{
+					pal_futex_wait(&once->state, PAL_ONCE_WAITING, NULL);
+					state = pal_atomic_u32_load(&once->state, PAL_ATOMIC_ACQUIRE);
+				}
+			}
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
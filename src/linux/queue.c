@@ -54,10 +54,7 @@ int pal_queue_create(pal_queue_t *queue, size_t item_size, size_t max_items)
 			queue->max_items = max_items;
 			queue->head		 = 0;
 			queue->tail		 = 0;
-			pthread_mutexattr_t attr;
-			pthread_mutexattr_init(&attr);
-			pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
-			pthread_mutex_init(&queue->mutex, &attr);
+			pthread_mutex_init(&queue->mutex, NULL);
 			pthread_cond_init(&queue->full, NULL);
 			pthread_cond_init(&queue->empty, NULL);
 			ret_code = 0;
@@ -0,0 +1,145 @@
+/*
+ * File: sem.c
+ * Description: Implementation of counting semaphore functionality for the Linux platform.
+ * Author: Massimiliano Ianniello
+ */
+
+#include "pal_os/sem.h"
+
+#include <errno.h>
+#include <time.h>
+
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
+
+/* ---------------------------------------------------------------------------
+ * Type Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Definitions
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Macros
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Constants
+ * ---------------------------------------------------------------------------
+ */
+
+/* ---------------------------------------------------------------------------
+ * Static Functions
+ * ---------------------------------------------------------------------------
+ */
+/**
+ * @brief Take one unit if any is available, without blocking.
+ * @param[in] sem Pointer to the semaphore.
+ * @return 0 if a unit was taken, or -1 if the count is 0.
+ */
+static int pal_sem_try_take(pal_sem_t *sem)
+{
+	int		 ret_code = -1;
+	uint32_t count	  = pal_atomic_u32_load(&sem->count, PAL_ATOMIC_SEQ_CST);
+	while (count)
+	{
+		if (pal_atomic_u32_compare_exchange(&sem->count, &count, count - 1, PAL_ATOMIC_SEQ_CST))
+		{
+			ret_code = 0;
+			break;
+		}
+	}
+	return ret_code;
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_sem_create(pal_sem_t *sem, size_t max_count, size_t initial_count)
+{
+	int ret_code = -1;
+	if (sem && max_count && max_count <= UINT32_MAX && initial_count <= max_count)
+	{
+		sem->count	   = (uint32_t)initial_count;
+		sem->waiters   = 0;
+		sem->max_count = (uint32_t)max_count;
+		ret_code	   = 0;
+	}
+	return ret_code;
+}
+
+int pal_sem_take(pal_sem_t *sem, size_t timeout_ms)
+{
+	int ret_code = -1;
+	if (sem)
+	{
+		ret_code = pal_sem_try_take(sem);
+		if (0 != ret_code && PAL_OS_NO_TIMEOUT != timeout_ms)
+		{
+			struct timespec	 ts;
+			struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+			// The waiter is published before the count is checked again, so a concurrent give either sees it or leaves a unit
+			pal_atomic_u32_fetch_add(&sem->waiters, 1, PAL_ATOMIC_SEQ_CST);
+			while (0 != (ret_code = pal_sem_try_take(sem)))
+			{
+				if (ETIMEDOUT == pal_futex_wait(&sem->count, 0, deadline))
+				{
+					ret_code = pal_sem_try_take(sem);
+					break;
+				}
+			}
+			pal_atomic_u32_fetch_sub(&sem->waiters, 1, PAL_ATOMIC_RELAXED);
+		}
+	}
+	return ret_code;
+}
+
+int pal_sem_give(pal_sem_t *sem)
+{
+	int ret_code = -1;
+	if (sem)
+	{
+		uint32_t count = pal_atomic_u32_load(&sem->count, PAL_ATOMIC_RELAXED);
+		while (count < sem->max_count)
+		{
+			if (pal_atomic_u32_compare_exchange(&sem->count, &count, count + 1, PAL_ATOMIC_SEQ_CST))
+			{
+				if (0 != pal_atomic_u32_load(&sem->waiters, PAL_ATOMIC_SEQ_CST))
+				{
+					pal_futex_wake(&sem->count, 1);
+				}
+				ret_code = 0;
+				break;
+			}
+		}
+	}
+	return ret_code;
+}
+
+int pal_sem_give_from_isr(pal_sem_t *sem) { return pal_sem_give(sem); }
+
+size_t pal_sem_get_count(pal_sem_t *sem)
+{
+	size_t count = 0;
+	if (sem)
+	{
+		count = pal_atomic_u32_load(&sem->count, PAL_ATOMIC_RELAXED);
+	}
+	return count;
+}
+
+int pal_sem_destroy(pal_sem_t *sem)
+{
+	int ret_code = -1;
+	if (sem)
+	{
+		ret_code = 0 == pal_atomic_u32_load(&sem->waiters, PAL_ATOMIC_RELAXED) ? 0 : -1;
+	}
+	return ret_code;
+}
@@ -7,10 +7,11 @@
 #include "pal_os/signal.h"
 
 #include <errno.h>
-#include <stdlib.h>
 #include <string.h>
-#include <sys/time.h>
+#include <time.h>
 
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
 #include "pal_os/common.h"
 
 /* ---------------------------------------------------------------------------
@@ -27,16 +28,228 @@
  * Macros
  * ---------------------------------------------------------------------------
  */
+#define PAL_SIGNAL_STAT_ADD(signal, field, value) \
+	((signal)->stats ? (void)pal_atomic_size_fetch_add(&(signal)->stats->field, (size_t)(value), PAL_ATOMIC_RELAXED) : (void)0)	//!< Add to a statistics counter
+#define PAL_SIGNAL_STAT_SUB(signal, field, value) \
+	((signal)->stats ? (void)pal_atomic_size_fetch_sub(&(signal)->stats->field, (size_t)(value), PAL_ATOMIC_RELAXED) : (void)0)	//!< Subtract from a statistics counter
 
 /* ---------------------------------------------------------------------------
  * Constants
  * ---------------------------------------------------------------------------
  */
+#define PAL_SIGNAL_CANCELLED UINT32_MAX	 //!< Waiter state once its thread stopped waiting without being claimed
 
 /* ---------------------------------------------------------------------------
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Read the monotonic clock.
+ * @return CLOCK_MONOTONIC time in nanoseconds.
+ */
+static uint64_t pal_signal_now_ns(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Account the time elapsed since a waiter was claimed in the wake latency histogram.
+ * @param[in] signal Pointer to the signal object that claimed the waiter.
+ * @param[in] waiter Claimed waiter.
+ */
+static void pal_signal_stat_latency(pal_signal_t *signal, const struct pal_signal_waiter_s *waiter)
+{
+	if (NULL != signal->stats)
+	{
+		uint64_t latency_us = (pal_signal_now_ns() - waiter->claimed_ns) / 1000u;
+		size_t	 bucket		= 0;
+		while (latency_us && bucket < PAL_SIGNAL_LATENCY_BUCKETS - 1)
+		{
+			latency_us >>= 1;
+			bucket++;
+		}
+		pal_atomic_size_fetch_add(&signal->stats->wake_latency_us[bucket], 1, PAL_ATOMIC_RELAXED);
+	}
+}
+
+/**
+ * @brief Check whether the active signals satisfy a wait.
+ * @param[in] signals Bitmask of active signals.
+ * @param[in] mask Bitmask of signals waited for.
+ * @param[in] wait_all Non-zero if every signal in mask is needed.
+ * @return Non-zero if the wait is satisfied.
+ */
+static int pal_signal_is_satisfied(size_t signals, size_t mask, int wait_all)
+{
+	return wait_all ? (mask == (signals & mask)) : (0 != (signals & mask));
+}
+
+/**
+ * @brief Take the signals satisfying a wait, if they are all active, without blocking.
+ * @param[in] signal Pointer to the signal object.
+ * @param[in] mask Bitmask of signals waited for.
+ * @param[out] received_signals Signals of mask that are active.
+ * @param[in] clear_mask Non-zero to clear the received signals on success.
+ * @param[in] wait_all Non-zero if every signal in mask is needed.
+ * @return PAL_SIGNAL_SUCCESS if the wait is satisfied, PAL_SIGNAL_TIMEOUT otherwise.
+ */
+static pal_signal_ret_code_t pal_signal_try_take(pal_signal_t *signal, size_t mask, size_t *received_signals, int clear_mask, int wait_all)
+{
+	pal_signal_ret_code_t ret_code = PAL_SIGNAL_TIMEOUT;
+	size_t				  signals  = pal_atomic_size_load(&signal->signals, PAL_ATOMIC_SEQ_CST);
+	while (pal_signal_is_satisfied(signals, mask, wait_all))
+	{
+		if (!clear_mask || pal_atomic_size_compare_exchange(&signal->signals, &signals, signals & ~mask, PAL_ATOMIC_SEQ_CST))
+		{
+			ret_code = PAL_SIGNAL_SUCCESS;
+			break;
+		}
+	}
+	*received_signals = signals & mask;
+	return ret_code;
+}
+
+/**
+ * @brief Remove a waiter from the signal object, if it is still linked.
+ * @param[in] signal Pointer to the signal object, with the mutex held.
+ * @param[in] waiter Waiter to remove.
+ */
+static void pal_signal_unlink(pal_signal_t *signal, struct pal_signal_waiter_s *waiter)
+{
+	struct pal_signal_waiter_s **link = &signal->waiters;
+	while (*link && *link != waiter)
+	{
+		link = &(*link)->next;
+	}
+	if (*link)
+	{
+		pal_atomic_ptr_store((void **)link, waiter->next, PAL_ATOMIC_RELAXED);
+		PAL_SIGNAL_STAT_SUB(signal, waiters, 1);
+	}
+}
+
+/**
+ * @brief Register a waiter in the signal object.
+ * @param[in] signal Pointer to the signal object, with the mutex held.
+ * @param[in] waiter Waiter to register.
+ * @note The list head is published before the caller checks the signals again: either a concurrent set sees the waiter, or the
+ * caller sees the new signals.
+ */
+static void pal_signal_link(pal_signal_t *signal, struct pal_signal_waiter_s *waiter)
+{
+	waiter->next = signal->waiters;
+	pal_atomic_ptr_store((void **)&signal->waiters, waiter, PAL_ATOMIC_SEQ_CST);
+	PAL_SIGNAL_STAT_ADD(signal, waits, 1);
+	PAL_SIGNAL_STAT_ADD(signal, waiters, 1);
+}
+
+/**
+ * @brief Claim the thread owning a waiter, so no other waiter sharing its state can be satisfied.
+ * @param[in] waiter Waiter whose condition is met.
+ * @return true if the waiter was claimed, false if its thread was already claimed or stopped waiting.
+ */
+static bool pal_signal_claim(struct pal_signal_waiter_s *waiter)
+{
+	uint32_t expected = 0;
+	return pal_atomic_u32_compare_exchange(waiter->state, &expected, waiter->index + 1, PAL_ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief Wake the waiters whose condition is met by the active signals.
+ * @param[in] signal Pointer to the signal object, with the mutex held.
+ * @note Every waiter is evaluated against the same set of signals: the signals requested to be cleared are cleared only after the
+ * whole list has been walked, so waiters on the same bits are all released.
+ */
+static void pal_signal_wake(pal_signal_t *signal)
+{
+	size_t						 signals	= pal_atomic_size_load(&signal->signals, PAL_ATOMIC_SEQ_CST);
+	size_t						 clear_mask = 0;
+	struct pal_signal_waiter_s **link		= &signal->waiters;
+	while (*link)
+	{
+		struct pal_signal_waiter_s *waiter = *link;
+		if (pal_signal_is_satisfied(signals, waiter->mask, waiter->wait_all))
+		{
+			pal_atomic_ptr_store((void **)link, waiter->next, PAL_ATOMIC_RELAXED);
+			PAL_SIGNAL_STAT_SUB(signal, waiters, 1);
+			if (pal_signal_claim(waiter))
+			{
+				waiter->claimed_ns = signal->stats ? pal_signal_now_ns() : 0;
+				waiter->received   = signals & waiter->mask;
+				if (waiter->clear)
+				{
+					clear_mask |= waiter->received;
+				}
+				// The waiter reads its result only after taking the mutex, so it cannot leave while it is being woken
+				pal_futex_wake(waiter->state, 1);
+			}
+		}
+		else
+		{
+			link = &waiter->next;
+		}
+	}
+	if (clear_mask)
+	{
+		pal_atomic_size_fetch_and(&signal->signals, ~clear_mask, PAL_ATOMIC_SEQ_CST);
+	}
+}
+
+/**
+ * @brief Sleep until a waiter sharing the state is claimed or the deadline expires.
+ * @param[in,out] state Futex word shared by the waiters of the thread.
+ * @param[in] deadline Absolute deadline, or NULL to wait forever.
+ * @param[out] spurious Number of wakeups that found the state still unclaimed.
+ * @return Final state: the index of the claimed waiter plus one, or PAL_SIGNAL_CANCELLED on timeout.
+ * @note The caller must still take the mutex of every signal object it is linked to before reading the result.
+ */
+static uint32_t pal_signal_sleep(uint32_t *state, const struct timespec *deadline, size_t *spurious)
+{
+	uint32_t current = 0;
+	int		 err	 = 0;
+	*spurious		 = 0;
+	while (0 == (current = pal_atomic_u32_load(state, PAL_ATOMIC_ACQUIRE)) && ETIMEDOUT != err)
+	{
+		err = pal_futex_wait(state, 0, deadline);
+		if (ETIMEDOUT != err && 0 == pal_atomic_u32_load(state, PAL_ATOMIC_ACQUIRE))
+		{
+			(*spurious)++;
+		}
+	}
+	if (0 == current && pal_atomic_u32_compare_exchange(state, &current, PAL_SIGNAL_CANCELLED, PAL_ATOMIC_ACQ_REL))
+	{
+		current = PAL_SIGNAL_CANCELLED;
+	}
+	return current;
+}
+
+/**
+ * @brief Set signals and wake the waiters whose condition is now met.
+ * @param[in] signal Pointer to the signal object.
+ * @param[in] mask Bitmask of signals to set.
+ * @return 0 on success, or -1 on failure.
+ * @note The mutex is taken only if a waiter is registered.
+ */
+static int pal_signal_set_and_wake(pal_signal_t *signal, size_t mask)
+{
+	int ret_code = -1;
+	if (NULL != signal)
+	{
+		// Pairs with pal_signal_link: either the waiter is seen here, or the waiter sees the new signals
+		pal_atomic_size_fetch_or(&signal->signals, mask, PAL_ATOMIC_SEQ_CST);
+		PAL_SIGNAL_STAT_ADD(signal, sets, 1);
+		if (NULL != pal_atomic_ptr_load((void *const *)&signal->waiters, PAL_ATOMIC_SEQ_CST))
+		{
+			pthread_mutex_lock(&signal->mutex);
+			pal_signal_wake(signal);
+			pthread_mutex_unlock(&signal->mutex);
+		}
+		ret_code = 0;
+	}
+	return ret_code;
+}
 
 /* ---------------------------------------------------------------------------
  * Function Implementations
@@ -48,8 +261,9 @@ int pal_signal_create(pal_signal_t *signal)
 	if (NULL != signal)
 	{
 		pthread_mutex_init(&signal->mutex, NULL);
-		pthread_cond_init(&signal->cond, NULL);
+		signal->waiters = NULL;
 		signal->signals = 0;
+		signal->stats	= NULL;
 		ret_code		= 0;
 	}
 	return ret_code;
@@ -60,109 +274,182 @@ pal_signal_ret_code_t pal_signal_wait(pal_signal_t *signal, size_t mask, size_t
 	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
 	if (NULL != signal && NULL != received_signals)
 	{
-		int				wait_condition = wait_all ? (mask == (signal->signals & mask)) : (signal->signals & mask);
-		struct timespec ts;
-		if (PAL_OS_INFINITE_TIMEOUT != timeout_ms)
+		ret_code = pal_signal_try_take(signal, mask, received_signals, clear_mask, wait_all);
+		if (PAL_SIGNAL_SUCCESS != ret_code && PAL_OS_NO_TIMEOUT != timeout_ms)
 		{
-			struct timeval now;
-			gettimeofday(&now, NULL);
-			ts.tv_sec  = now.tv_sec + timeout_ms / 1000;
-			ts.tv_nsec = (now.tv_usec * 1000) + ((timeout_ms % 1000) * 1000000);
-			if (ts.tv_nsec >= 1000000000)
+			uint32_t				   state  = 0;
+			struct pal_signal_waiter_s waiter = {NULL, mask, wait_all, clear_mask, 0, &state, 0, 0};
+			struct timespec			   ts;
+			struct timespec			  *deadline = pal_futex_deadline(timeout_ms, &ts);
+			pthread_mutex_lock(&signal->mutex);
+			pal_signal_link(signal, &waiter);
+			ret_code = pal_signal_try_take(signal, mask, received_signals, clear_mask, wait_all);
+			if (PAL_SIGNAL_SUCCESS != ret_code)
 			{
-				ts.tv_sec += ts.tv_nsec / 1000000000;
-				ts.tv_nsec %= 1000000000;
-			}
-		}
-		pthread_mutex_lock(&signal->mutex);
-		switch (timeout_ms)
-		{
-			case PAL_OS_NO_TIMEOUT:
-				if (wait_all)
+				size_t spurious;
+				pthread_mutex_unlock(&signal->mutex);
+				uint32_t claimed = pal_signal_sleep(&state, deadline, &spurious);
+				pthread_mutex_lock(&signal->mutex);
+				PAL_SIGNAL_STAT_ADD(signal, spurious_wakeups, spurious);
+				if (PAL_SIGNAL_CANCELLED != claimed)
 				{
-					ret_code = (mask == (signal->signals & mask)) ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
+					*received_signals = waiter.received;
+					ret_code		  = PAL_SIGNAL_SUCCESS;
+					pal_signal_stat_latency(signal, &waiter);
 				}
 				else
 				{
-					ret_code = (signal->signals & mask) ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
-				}
-				break;
-			case PAL_OS_INFINITE_TIMEOUT:
-				while (!wait_condition)
-				{
-					pthread_cond_wait(&signal->cond, &signal->mutex);
-					wait_condition = wait_all ? (mask == (signal->signals & mask)) : (signal->signals & mask);
+					*received_signals = pal_atomic_size_load(&signal->signals, PAL_ATOMIC_RELAXED) & mask;
+					PAL_SIGNAL_STAT_ADD(signal, timeouts, 1);
 				}
-				ret_code = PAL_SIGNAL_SUCCESS;
-				break;
-			default:
-				ret_code = PAL_SIGNAL_SUCCESS;
-				while (!wait_condition)
+			}
+			pal_signal_unlink(signal, &waiter);
+			pthread_mutex_unlock(&signal->mutex);
+		}
+	}
+	return ret_code;
+}
+
+pal_signal_ret_code_t pal_signal_wait_multi(pal_signal_wait_entry_t *entries, size_t count, size_t *index, size_t timeout_ms)
+{
+	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
+	size_t				  linked   = 0;
+	while (NULL != entries && NULL != index && linked < count && NULL != entries[linked].signal)
+	{
+		linked++;
+	}
+	if (linked && linked == count && count < PAL_SIGNAL_CANCELLED)
+	{
+		uint32_t		 state = 0;
+		uint32_t		 claimed;
+		size_t			 spurious;
+		struct timespec	 ts;
+		struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+		for (linked = 0; linked < count && 0 == pal_atomic_u32_load(&state, PAL_ATOMIC_ACQUIRE); linked++)
+		{
+			pal_signal_wait_entry_t *entry = &entries[linked];
+			entry->waiter = (struct pal_signal_waiter_s){NULL, entry->mask, entry->wait_all, entry->clear_mask, 0, &state, (uint32_t)linked, 0};
+			pthread_mutex_lock(&entry->signal->mutex);
+			pal_signal_link(entry->signal, &entry->waiter);
+			size_t signals = pal_atomic_size_load(&entry->signal->signals, PAL_ATOMIC_SEQ_CST);
+			if (pal_signal_is_satisfied(signals, entry->mask, entry->wait_all) && pal_signal_claim(&entry->waiter))
+			{
+				entry->waiter.claimed_ns = entry->signal->stats ? pal_signal_now_ns() : 0;
+				entry->waiter.received	 = signals & entry->mask;
+				if (entry->clear_mask)
 				{
-					int err = pthread_cond_timedwait(&signal->cond, &signal->mutex, &ts);
-					if (0 != err)
-					{
-						ret_code = PAL_SIGNAL_FAILURE;
-						if (ETIMEDOUT == err)
-						{
-							ret_code = PAL_SIGNAL_TIMEOUT;
-						}
-						break;
-					}
-					wait_condition = wait_all ? (mask == (signal->signals & mask)) : (signal->signals & mask);
+					pal_atomic_size_fetch_and(&entry->signal->signals, ~entry->waiter.received, PAL_ATOMIC_SEQ_CST);
 				}
-				break;
+			}
+			pthread_mutex_unlock(&entry->signal->mutex);
 		}
-		pthread_mutex_unlock(&signal->mutex);
-		*received_signals = signal->signals & mask;
-		if (clear_mask && PAL_SIGNAL_SUCCESS == ret_code)
+		// With PAL_OS_NO_TIMEOUT the deadline is already expired, so this only settles the state
+		claimed = pal_signal_sleep(&state, deadline, &spurious);
+		// Taking every mutex also waits for the claiming set to be done with the waiters
+		for (size_t i = 0; i < linked; i++)
+		{
+			pthread_mutex_lock(&entries[i].signal->mutex);
+			pal_signal_unlink(entries[i].signal, &entries[i].waiter);
+			pthread_mutex_unlock(&entries[i].signal->mutex);
+			PAL_SIGNAL_STAT_ADD(entries[i].signal, spurious_wakeups, spurious);
+			PAL_SIGNAL_STAT_ADD(entries[i].signal, timeouts, PAL_SIGNAL_CANCELLED == claimed);
+		}
+		ret_code = PAL_SIGNAL_TIMEOUT;
+		if (PAL_SIGNAL_CANCELLED != claimed)
 		{
-			signal->signals &= ~(*received_signals);
+			*index							 = claimed - 1;
+			entries[*index].received_signals = entries[*index].waiter.received;
+			ret_code						 = PAL_SIGNAL_SUCCESS;
+			pal_signal_stat_latency(entries[*index].signal, &entries[*index].waiter);
 		}
 	}
 	return ret_code;
 }
 
-int pal_signal_set(pal_signal_t *signal, size_t mask)
+pal_signal_ret_code_t pal_signal_sync(pal_signal_t *signal, size_t set_mask, size_t wait_mask, size_t timeout_ms)
 {
-	int ret_code = -1;
-	if (NULL != signal)
+	pal_signal_ret_code_t ret_code = PAL_SIGNAL_FAILURE;
+	if (NULL != signal && wait_mask)
 	{
+		uint32_t				   state  = 0;
+		struct pal_signal_waiter_s waiter = {NULL, wait_mask, 1, 1, 0, &state, 0, 0};
+		struct timespec			   ts;
+		struct timespec			  *deadline = pal_futex_deadline(timeout_ms, &ts);
 		pthread_mutex_lock(&signal->mutex);
-		signal->signals |= mask;
-		if (0 == pthread_cond_signal(&signal->cond))
+		// The caller is registered before its signals are set, so the same walk releases it together with the other parties
+		pal_signal_link(signal, &waiter);
+		pal_atomic_size_fetch_or(&signal->signals, set_mask, PAL_ATOMIC_SEQ_CST);
+		pal_signal_wake(signal);
+		ret_code = 0 != state ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
+		if (PAL_SIGNAL_SUCCESS != ret_code && PAL_OS_NO_TIMEOUT != timeout_ms)
 		{
-			ret_code = 0;
+			size_t spurious;
+			pthread_mutex_unlock(&signal->mutex);
+			uint32_t claimed = pal_signal_sleep(&state, deadline, &spurious);
+			pthread_mutex_lock(&signal->mutex);
+			PAL_SIGNAL_STAT_ADD(signal, spurious_wakeups, spurious);
+			ret_code = PAL_SIGNAL_CANCELLED != claimed ? PAL_SIGNAL_SUCCESS : PAL_SIGNAL_TIMEOUT;
+			if (PAL_SIGNAL_SUCCESS == ret_code)
+			{
+				pal_signal_stat_latency(signal, &waiter);
+			}
+		}
+		if (PAL_SIGNAL_TIMEOUT == ret_code)
+		{
+			PAL_SIGNAL_STAT_ADD(signal, timeouts, 1);
 		}
+		pal_signal_unlink(signal, &waiter);
 		pthread_mutex_unlock(&signal->mutex);
 	}
 	return ret_code;
 }
 
-int pal_signal_set_from_isr(pal_signal_t *signal, size_t mask)
+int pal_signal_set(pal_signal_t *signal, size_t mask) { return pal_signal_set_and_wake(signal, mask); }
+
+int pal_signal_set_from_isr(pal_signal_t *signal, size_t mask) { return pal_signal_set_and_wake(signal, mask); }
+
+int pal_signal_clear(pal_signal_t *signal, size_t mask)
 {
 	int ret_code = -1;
 	if (NULL != signal)
 	{
-		pthread_mutex_lock(&signal->mutex);
-		signal->signals |= mask;
-		if (0 == pthread_cond_signal(&signal->cond))
+		pal_atomic_size_fetch_and(&signal->signals, ~mask, PAL_ATOMIC_SEQ_CST);
+		PAL_SIGNAL_STAT_ADD(signal, clears, 1);
+		ret_code = 0;
+	}
+	return ret_code;
+}
+
+int pal_signal_enable_stats(pal_signal_t *signal, pal_signal_stats_t *stats)
+{
+	int ret_code = -1;
+	if (NULL != signal)
+	{
+		if (NULL != stats)
 		{
-			ret_code = 0;
+			memset(stats, 0, sizeof(*stats));
 		}
-		pthread_mutex_unlock(&signal->mutex);
+		signal->stats = stats;
+		ret_code	  = 0;
 	}
 	return ret_code;
 }
 
-int pal_signal_clear(pal_signal_t *signal, size_t mask)
+int pal_signal_get_stats(pal_signal_t *signal, pal_signal_stats_t *stats)
 {
 	int ret_code = -1;
-	if (NULL != signal)
+	if (NULL != signal && NULL != signal->stats && NULL != stats)
 	{
-		pthread_mutex_lock(&signal->mutex);
-		signal->signals &= ~mask;
-		pthread_mutex_unlock(&signal->mutex);
+		stats->sets				= pal_atomic_size_load(&signal->stats->sets, PAL_ATOMIC_RELAXED);
+		stats->clears			= pal_atomic_size_load(&signal->stats->clears, PAL_ATOMIC_RELAXED);
+		stats->waits			= pal_atomic_size_load(&signal->stats->waits, PAL_ATOMIC_RELAXED);
+		stats->waiters			= pal_atomic_size_load(&signal->stats->waiters, PAL_ATOMIC_RELAXED);
+		stats->timeouts			= pal_atomic_size_load(&signal->stats->timeouts, PAL_ATOMIC_RELAXED);
+		stats->spurious_wakeups = pal_atomic_size_load(&signal->stats->spurious_wakeups, PAL_ATOMIC_RELAXED);
+		for (size_t i = 0; i < PAL_SIGNAL_LATENCY_BUCKETS; i++)
+		{
+			stats->wake_latency_us[i] = pal_atomic_size_load(&signal->stats->wake_latency_us[i], PAL_ATOMIC_RELAXED);
+		}
 		ret_code = 0;
 	}
 	return ret_code;
@@ -174,7 +461,6 @@ int pal_signal_destroy(pal_signal_t *signal)
 	if (NULL != signal)
 	{
 		pthread_mutex_destroy(&signal->mutex);
-		pthread_cond_destroy(&signal->cond);
 		ret_code = 0;
 	}
 	return ret_code;
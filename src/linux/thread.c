@@ -4,11 +4,16 @@
  * Author: Massimiliano Ianniello
  */
 
+#include <errno.h>	  // For ETIMEDOUT
 #include <pthread.h>  // POSIX threads for thread management
 #include <stdint.h>	  // For SIZE_MAX
 #include <stdlib.h>	  // For malloc and free
 #include <string.h>	  // For strlen
+#include <sys/syscall.h>  // For SYS_gettid
+#include <unistd.h>		  // For syscall
 
+#include "futex_priv.h"
+#include "pal_os/atomic.h"
 #include "thread_priv.h"  // Include the private header file
 #include "timer_priv.h"
 /* ---------------------------------------------------------------------------
@@ -20,6 +25,8 @@
  * Static Definitions
  * ---------------------------------------------------------------------------
  */
+static _Thread_local uint32_t	  pal_thread_self_id = 0;	   //!< Cached kernel id of the calling thread
+static _Thread_local pal_thread_t *pal_thread_current = NULL;  //!< pal thread structure of the calling thread
 
 /* ---------------------------------------------------------------------------
  * Macros
@@ -30,6 +37,9 @@
  * Constants
  * ---------------------------------------------------------------------------
  */
+#define PAL_THREAD_NOTIFY_NONE	  0	 //!< No notification pending
+#define PAL_THREAD_NOTIFY_PENDING 1	 //!< A notification is pending
+#define PAL_THREAD_NOTIFY_WAITING 2	 //!< The thread is blocked waiting for a notification
 
 /* ---------------------------------------------------------------------------
  * Static Functions
@@ -46,12 +56,14 @@ int pal_thread_create(pal_thread_t *thread, const pal_thread_priority_t priority
 	int ret_code = -1;
 	if (NULL != thread && NULL != func && 0 != stack_size)
 	{
-		thread->func	   = func;
-		thread->arg		   = arg;
-		thread->stack_size = stack_size;
-		thread->priority   = priority;
-		thread->name	   = name;
-		thread->state	   = PAL_THREAD_STATE_STOPPED;
+		thread->func		 = func;
+		thread->arg			 = arg;
+		thread->stack_size	 = stack_size;
+		thread->priority	 = priority;
+		thread->name		 = name;
+		thread->state		 = PAL_THREAD_STATE_STOPPED;
+		thread->notify_value = 0;
+		thread->notify_state = PAL_THREAD_NOTIFY_NONE;
 
 		pthread_attr_t attr;
 		pthread_attr_init(&attr);
@@ -103,11 +115,101 @@ size_t pal_thread_get_stack_watermark(pal_thread_t *const thread)
 	return 0;
 }
 
+int pal_thread_notify(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action)
+{
+	int ret_code = -1;
+	if (thread)
+	{
+		ret_code = 0;
+		switch (action)
+		{
+			case PAL_THREAD_NOTIFY_SET_BITS:
+				pal_atomic_u32_fetch_or(&thread->notify_value, value, PAL_ATOMIC_RELAXED);
+				break;
+			case PAL_THREAD_NOTIFY_INCREMENT:
+				pal_atomic_u32_fetch_add(&thread->notify_value, 1, PAL_ATOMIC_RELAXED);
+				break;
+			case PAL_THREAD_NOTIFY_OVERWRITE:
+				pal_atomic_u32_store(&thread->notify_value, value, PAL_ATOMIC_RELAXED);
+				break;
+			default:
+				ret_code = -1;
+				break;
+		}
+		if (0 == ret_code && PAL_THREAD_NOTIFY_WAITING == pal_atomic_u32_exchange(&thread->notify_state, PAL_THREAD_NOTIFY_PENDING, PAL_ATOMIC_RELEASE))
+		{
+			pal_futex_wake(&thread->notify_state, 1);
+		}
+	}
+	return ret_code;
+}
+
+int pal_thread_notify_from_isr(pal_thread_t *const thread, uint32_t value, pal_thread_notify_action_t action) { return pal_thread_notify(thread, value, action); }
+
+int pal_thread_notify_wait(uint32_t clear_on_entry, uint32_t clear_on_exit, uint32_t *value, size_t timeout_ms)
+{
+	int			  ret_code = -1;
+	pal_thread_t *thread   = pal_thread_current;
+	if (thread)
+	{
+		struct timespec	 ts;
+		struct timespec *deadline = pal_futex_deadline(timeout_ms, &ts);
+		uint32_t		 state	  = pal_atomic_u32_load(&thread->notify_state, PAL_ATOMIC_ACQUIRE);
+		if (PAL_THREAD_NOTIFY_PENDING != state)
+		{
+			pal_atomic_u32_fetch_and(&thread->notify_value, ~clear_on_entry, PAL_ATOMIC_RELAXED);
+		}
+		while (PAL_THREAD_NOTIFY_PENDING != state && PAL_OS_NO_TIMEOUT != timeout_ms)
+		{
+			// Only the owner thread moves the state away from pending, so a failed exchange means a notification arrived
+			if (pal_atomic_u32_compare_exchange(&thread->notify_state, &state, PAL_THREAD_NOTIFY_WAITING, PAL_ATOMIC_ACQUIRE) ||
+				PAL_THREAD_NOTIFY_WAITING == state)
+			{
+				if (ETIMEDOUT == pal_futex_wait(&thread->notify_state, PAL_THREAD_NOTIFY_WAITING, deadline))
+				{
+					state = PAL_THREAD_NOTIFY_WAITING;
+					pal_atomic_u32_compare_exchange(&thread->notify_state, &state, PAL_THREAD_NOTIFY_NONE, PAL_ATOMIC_ACQUIRE);
+					state = pal_atomic_u32_load(&thread->notify_state, PAL_ATOMIC_ACQUIRE);
+					break;
+				}
+				state = pal_atomic_u32_load(&thread->notify_state, PAL_ATOMIC_ACQUIRE);
+			}
+		}
+		uint32_t notify_value = 0;
+		if (PAL_THREAD_NOTIFY_PENDING == state)
+		{
+			// Acquire every notification consumed here, including one that raced in after the state was read
+			pal_atomic_u32_exchange(&thread->notify_state, PAL_THREAD_NOTIFY_NONE, PAL_ATOMIC_ACQUIRE);
+			notify_value = pal_atomic_u32_fetch_and(&thread->notify_value, ~clear_on_exit, PAL_ATOMIC_RELAXED);
+			ret_code = 0;
+		}
+		else
+		{
+			notify_value = pal_atomic_u32_load(&thread->notify_value, PAL_ATOMIC_RELAXED);
+		}
+		if (value)
+		{
+			*value = notify_value;
+		}
+	}
+	return ret_code;
+}
+
 void pal_thread_free(pal_thread_t *thread) { (void)thread; }
 
 void *pal_thread_generic_func(void *const arg)
 {
 	pal_thread_t *thread = (pal_thread_t *)arg;
+	pal_thread_current	 = thread;
 	thread->func(thread->arg);
 	return NULL;
+}
+
+uint32_t pal_thread_get_self_id(void)
+{
+	if (0 == pal_thread_self_id)
+	{
+		pal_thread_self_id = (uint32_t)syscall(SYS_gettid);
+	}
+	return pal_thread_self_id;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@ extern "C"
 // ============================
 #include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "pal_os/thread.h"
 
@@ -31,6 +32,13 @@ extern "C"
  */
 void *pal_thread_generic_func(void *const arg);
 
+/**
+ * @brief Get the kernel id of the calling thread.
+ * @note The id is cached in thread-local storage, so only the first call per thread enters the kernel.
+ * @return Thread id, never 0.
+ */
+uint32_t pal_thread_get_self_id(void);
+
 #ifdef __cplusplus
 }
 #endif
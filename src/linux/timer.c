@@ -4,18 +4,28 @@
  * Author: Massimiliano Ianniello
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE	 //!< CPU affinity of the shard threads and sched_getcpu
+#endif
+
 #include "pal_os/timer.h"
 
 #include <errno.h>
-#include <malloc.h>
 #include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/prctl.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
+#include "pal_os/atomic.h"
+#include "pal_os/common.h"
 #include "timer_priv.h"
 /* ---------------------------------------------------------------------------
  * Type Definitions
  * ---------------------------------------------------------------------------
  */
-
 /* ---------------------------------------------------------------------------
  * Static Definitions
  * ---------------------------------------------------------------------------
@@ -25,208 +35,1193 @@
  * Macros
  * ---------------------------------------------------------------------------
  */
+#define PAL_TIMER_MS_TO_NS(ms) ((uint64_t)(ms) * 1000000ULL)	//!< Convert milliseconds to nanoseconds
+#define PAL_TIMER_US_TO_NS(us) ((uint64_t)(us) * 1000ULL)		//!< Convert microseconds to nanoseconds
 
 /* ---------------------------------------------------------------------------
  * Constants
  * ---------------------------------------------------------------------------
  */
+#define PAL_TIMER_NS_PER_SEC	1000000000ULL								//!< Nanoseconds in a second
+#define PAL_TIMER_WHEEL_TICK_NS PAL_TIMER_MS_TO_NS(PAL_TIMER_WHEEL_TICK_MS)	//!< Granularity of the timing wheel in nanoseconds
 
 /* ---------------------------------------------------------------------------
  * Variables
  * ---------------------------------------------------------------------------
  */
-pal_timer_env_t pal_timer_environment = {
-	.thread_handle = 0,
-	.mutex		   = PTHREAD_MUTEX_INITIALIZER,
-	.cond		   = PTHREAD_COND_INITIALIZER,
-	.timer_list	   = NULL,
-	.shutdown_flag = 0,
+// A range designator gives every shard the same static initializer, so their mutexes are usable before pal_timer_init
+__extension__ pal_timer_env_t pal_timer_environment[PAL_TIMER_MAX_SHARDS] = {
+	[0 ... PAL_TIMER_MAX_SHARDS - 1] = {
+		.thread_handle = 0,
+		.mutex		   = PTHREAD_MUTEX_INITIALIZER,
+		.cond		   = PTHREAD_COND_INITIALIZER,
+		.heap		   = NULL,
+		.heap_size	   = 0,
+		.heap_capacity = 0,
+		.wheel		   = {NULL},
+		.wheel_size	   = 0,
+		.wheel_tick	   = 0,
+		.expired_head  = NULL,
+		.expired_tail  = NULL,
+		.batch		   = {NULL},
+		.batch_size	   = 0,
+		.pool_size	   = 0,
+		.pool_cond	   = PTHREAD_COND_INITIALIZER,
+		.idle_cond	   = PTHREAD_COND_INITIALIZER,
+		.pool_head	   = NULL,
+		.pool_tail	   = NULL,
+		.use_timerfd   = PAL_TIMER_USE_TIMERFD,
+		.wakeup_fd	   = -1,
+		.armed_time	   = {0, 0},
+		.wakeups	   = 0,
+		.shutdown_flag = 0,
+	},
 };
 
+static size_t pal_timer_shard_count = 1;  //!< Number of shards started by pal_timer_init
+
+static _Thread_local pal_timer_t *pal_timer_running = NULL;	 //!< Timer whose callback the calling thread runs
+
 /* ---------------------------------------------------------------------------
  * Static Functions
  * ---------------------------------------------------------------------------
  */
+/**
+ * @brief Get the shard serving a timer.
+ * @param[in] timer Pointer to the timer.
+ * @return Pointer to the shard.
+ */
+static pal_timer_env_t *pal_timer_env(const pal_timer_t *timer) { return &pal_timer_environment[timer->shard]; }
 
-/* ---------------------------------------------------------------------------
- * Function Implementations
- * ---------------------------------------------------------------------------
+/**
+ * @brief Lock the shard serving a timer.
+ * @param[in] timer Pointer to the timer.
+ * @return Pointer to the locked shard.
+ * @note A timer only moves with both shards locked, so the shard read while holding the lock of the shard it names is current.
  */
-int pal_timer_init(void) { return (0 == pthread_create(&pal_timer_environment.thread_handle, NULL, pal_timer_thread_fn, NULL)) ? 0 : -1; }
+static pal_timer_env_t *pal_timer_lock(const pal_timer_t *timer)
+{
+	pal_timer_env_t *env = NULL;
+	do
+	{
+		if (env)
+		{
+			pthread_mutex_unlock(&env->mutex);
+		}
+		env = &pal_timer_environment[pal_atomic_size_load(&timer->shard, PAL_ATOMIC_RELAXED)];
+		pthread_mutex_lock(&env->mutex);
+	} while (env != &pal_timer_environment[pal_atomic_size_load(&timer->shard, PAL_ATOMIC_RELAXED)]);
+	return env;
+}
 
-void pal_timer_deinit(void)
+/**
+ * @brief Get the shard serving the timers created on the calling CPU.
+ * @return Index of the shard.
+ */
+static size_t pal_timer_cpu_shard(void)
+{
+	int cpu = sched_getcpu();
+	return cpu >= 0 ? (size_t)cpu % pal_timer_shard_count : 0;
+}
+
+/**
+ * @brief Store a timer at a heap position, keeping its index up to date.
+ * @param[in] timer Pointer to the timer.
+ * @param[in] index Heap position.
+ */
+static void pal_os_timer_heap_place(pal_timer_t *timer, size_t index)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	env->heap[index]	 = timer;
+	timer->heap_index	 = index;
+}
+
+/**
+ * @brief Move a timer towards the root while it expires before its parent.
+ * @param[in] timer Pointer to the timer, already in the heap.
+ */
+static void pal_os_timer_heap_sift_up(pal_timer_t *timer)
 {
-	if (pal_timer_environment.thread_handle)
+	pal_timer_env_t *env   = pal_timer_env(timer);
+	size_t			 index = timer->heap_index;
+	while (index > 0)
 	{
-		pthread_mutex_lock(&pal_timer_environment.mutex);
-		pal_timer_environment.shutdown_flag = 1;
-		pthread_cond_signal(&pal_timer_environment.cond);
-		pthread_mutex_unlock(&pal_timer_environment.mutex);
-		pthread_join(pal_timer_environment.thread_handle, NULL);
-		pal_timer_environment.thread_handle = 0;
-		pal_timer_t *timer					= pal_timer_environment.timer_list;
-		while (timer)
+		size_t		 parent_index = (index - 1) / 2;
+		pal_timer_t *parent		  = env->heap[parent_index];
+		if (pal_os_timer_time_cmp(&parent->latest_time, &timer->latest_time) <= 0)
 		{
-			pal_timer_t *next = timer->next;
-			timer			  = next;
+			break;
 		}
-		pal_timer_environment.timer_list	= NULL;
-		pal_timer_environment.shutdown_flag = 0;
+		pal_os_timer_heap_place(parent, index);
+		index = parent_index;
 	}
+	pal_os_timer_heap_place(timer, index);
 }
 
-int pal_os_timer_time_cmp(const struct timespec *a, const struct timespec *b)
+/**
+ * @brief Move a timer towards the leaves while a child expires before it.
+ * @param[in] timer Pointer to the timer, already in the heap.
+ */
+static void pal_os_timer_heap_sift_down(pal_timer_t *timer)
 {
-	int result = 0;
-	if (a->tv_sec == b->tv_sec)
+	pal_timer_env_t *env   = pal_timer_env(timer);
+	size_t			 index = timer->heap_index;
+	while (1)
 	{
-		result = a->tv_nsec - b->tv_nsec;
+		size_t child_index = 2 * index + 1;
+		if (child_index >= env->heap_size)
+		{
+			break;
+		}
+		if (child_index + 1 < env->heap_size &&
+			pal_os_timer_time_cmp(&env->heap[child_index + 1]->latest_time, &env->heap[child_index]->latest_time) < 0)
+		{
+			child_index++;
+		}
+		pal_timer_t *child = env->heap[child_index];
+		if (pal_os_timer_time_cmp(&timer->latest_time, &child->latest_time) <= 0)
+		{
+			break;
+		}
+		pal_os_timer_heap_place(child, index);
+		index = child_index;
+	}
+	pal_os_timer_heap_place(timer, index);
+}
+
+/**
+ * @brief Check whether a timer is stored in the heap.
+ * @param[in] timer Pointer to the timer.
+ * @return Non-zero if the timer is in the heap.
+ */
+static int pal_os_timer_heap_contains(const pal_timer_t *timer)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	return timer->heap_index < env->heap_size && timer == env->heap[timer->heap_index];
+}
+
+/**
+ * @brief Convert a time to nanoseconds.
+ * @param[in] time Pointer to the time.
+ * @return Time in nanoseconds.
+ */
+static uint64_t pal_os_timer_ns(const struct timespec *time) { return (uint64_t)time->tv_sec * PAL_TIMER_NS_PER_SEC + (uint64_t)time->tv_nsec; }
+
+/**
+ * @brief Convert nanoseconds to a time.
+ * @param[in] ns Time in nanoseconds.
+ * @param[out] time Pointer to the time.
+ */
+static void pal_os_timer_from_ns(uint64_t ns, struct timespec *time)
+{
+	time->tv_sec  = (time_t)(ns / PAL_TIMER_NS_PER_SEC);
+	time->tv_nsec = (long)(ns % PAL_TIMER_NS_PER_SEC);
+}
+
+/**
+ * @brief Unlink a timer from a doubly linked list.
+ * @param[in,out] head Pointer to the first timer of the list.
+ * @param[in,out] tail Pointer to the last timer of the list, or NULL if the list does not track it.
+ * @param[in] timer Pointer to the timer, which must be in the list.
+ */
+static void pal_os_timer_list_unlink(struct pal_timer_s **head, struct pal_timer_s **tail, pal_timer_t *timer)
+{
+	if (timer->prev)
+	{
+		timer->prev->next = timer->next;
 	}
 	else
 	{
-		result = a->tv_sec - b->tv_sec;
+		*head = timer->next;
 	}
-	return result;
+	if (timer->next)
+	{
+		timer->next->prev = timer->prev;
+	}
+	else if (tail)
+	{
+		*tail = timer->prev;
+	}
+	timer->prev = NULL;
+	timer->next = NULL;
 }
 
-void pal_os_timer_insert_sorted(pal_timer_t *timer)
+/**
+ * @brief Append a due timer to the expired list.
+ * @param[in] timer Pointer to the timer, which must not be in any list.
+ */
+static void pal_os_timer_expired_push(pal_timer_t *timer)
 {
-	// Insert the timer into the sorted list based on its expiry time
-	pal_timer_t *prev = NULL;
-	pal_timer_t *cur  = pal_timer_environment.timer_list;
+	pal_timer_env_t *env = pal_timer_env(timer);
+	timer->prev			 = env->expired_tail;
+	timer->next			 = NULL;
+	if (env->expired_tail)
+	{
+		env->expired_tail->next = timer;
+	}
+	else
+	{
+		env->expired_head = timer;
+	}
+	env->expired_tail = timer;
+	timer->queue	  = PAL_TIMER_QUEUE_EXPIRED;
+}
 
-	while (cur && pal_os_timer_time_cmp(&cur->expiry_time, &timer->expiry_time) < 0)
+/**
+ * @brief Remove a timer from whichever structure holds it.
+ * @param[in] timer Pointer to the timer.
+ */
+static void pal_timer_unqueue(pal_timer_t *timer)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	switch (timer->queue)
 	{
-		prev = cur;
-		cur	 = cur->next;
+		case PAL_TIMER_QUEUE_HEAP:
+			pal_os_timer_heap_remove(timer);
+			break;
+		case PAL_TIMER_QUEUE_WHEEL:
+			pal_os_timer_wheel_remove(timer);
+			break;
+		case PAL_TIMER_QUEUE_EXPIRED:
+			pal_os_timer_list_unlink(&env->expired_head, &env->expired_tail, timer);
+			timer->queue = PAL_TIMER_QUEUE_NONE;
+			break;
+		default:
+			break;
 	}
+}
 
-	if (prev)
+/**
+ * @brief Get the time the timer thread of a shard must handle its next timers at.
+ * @param[in] env Pointer to the shard.
+ * @param[out] deadline Pointer to the time the next timers are due at.
+ * @param[out] wakeup Pointer to the time the timer thread must wake up at, ahead of the deadline by the spin window of the next timer.
+ * @return Non-zero if a wakeup is needed, zero if no timer is scheduled.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_next_deadline(pal_timer_env_t *env, struct timespec *deadline, struct timespec *wakeup)
+{
+	int			 ret_code = 1;
+	uint64_t	 spin	  = 0;
+	pal_timer_t *timer	  = pal_os_timer_heap_top(env);
+	if (env->expired_head)
 	{
-		prev->next = timer;
+		// Due timers are waiting already, any time in the past wakes up at once
+		deadline->tv_sec  = 0;
+		deadline->tv_nsec = 1;
+	}
+	else if (env->wheel_size)
+	{
+		// The next wheel tick, or the first heap expiry if it comes earlier
+		pal_os_timer_from_ns((env->wheel_tick + 1) * PAL_TIMER_WHEEL_TICK_NS, deadline);
+		if (timer && pal_os_timer_time_cmp(&timer->latest_time, deadline) < 0)
+		{
+			*deadline = timer->latest_time;
+			spin	  = PAL_TIMER_US_TO_NS(timer->spin_us);
+		}
+	}
+	else if (timer)
+	{
+		// The end of the earliest slack window, every window opened by then shares the wakeup
+		*deadline = timer->latest_time;
+		spin	  = PAL_TIMER_US_TO_NS(timer->spin_us);
 	}
 	else
 	{
-		pal_timer_environment.timer_list = timer;
+		ret_code = 0;
+	}
+	if (ret_code)
+	{
+		uint64_t deadline_ns = pal_os_timer_ns(deadline);
+		pal_os_timer_from_ns(deadline_ns > spin ? deadline_ns - spin : 1, wakeup);
 	}
+	return ret_code;
+}
 
-	timer->next = cur;
+/**
+ * @brief Arm the timerfd of a shard for a wakeup time, unless it is armed for that time already.
+ * @param[in] env Pointer to the shard.
+ * @param[in] deadline Pointer to the absolute CLOCK_MONOTONIC wakeup time, or NULL to disarm the timerfd.
+ * @note The caller must hold the environment mutex.
+ */
+static void pal_timer_set_wakeup(pal_timer_env_t *env, const struct timespec *deadline)
+{
+	struct itimerspec spec = {{0, 0}, {0, 0}};
+	if (deadline)
+	{
+		spec.it_value = *deadline;
+	}
+	if (0 != pal_os_timer_time_cmp(&spec.it_value, &env->armed_time))
+	{
+		timerfd_settime(env->wakeup_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+		env->armed_time = spec.it_value;
+	}
 }
 
-void pal_os_timer_remove(pal_timer_t *timer)
+/**
+ * @brief Make the timer thread of a shard notice that its scheduled timers changed.
+ * @param[in] env Pointer to the shard.
+ * @note With a timerfd the earliest deadline is armed directly, and the kernel timer is only touched when that deadline moves.
+ * The timer thread itself computes its wakeup before waiting. The caller must hold the environment mutex.
+ */
+static void pal_timer_wake_service(pal_timer_env_t *env)
 {
-	// Remove the timer from the sorted list
-	pal_timer_t *prev = NULL;
-	pal_timer_t *cur  = pal_timer_environment.timer_list;
+	if (!pthread_equal(pthread_self(), env->thread_handle))
+	{
+		if (env->wakeup_fd >= 0)
+		{
+			struct timespec deadline;
+			struct timespec wakeup;
+			pal_timer_set_wakeup(env, pal_timer_next_deadline(env, &deadline, &wakeup) ? &wakeup : NULL);
+		}
+		else
+		{
+			pthread_cond_signal(&env->cond);
+		}
+	}
+}
 
-	while (cur && cur != timer)
+/**
+ * @brief Block the timer thread of a shard until its next wakeup time or until its scheduled timers change.
+ * @param[in] env Pointer to the shard.
+ * @note A wakeup ahead of the deadline busy-waits for the rest of the spin window. The caller must hold the environment mutex, which is
+ * released while waiting.
+ */
+static void pal_timer_wait(pal_timer_env_t *env)
+{
+	struct timespec deadline;
+	struct timespec wakeup;
+	int				has_deadline = pal_timer_next_deadline(env, &deadline, &wakeup);
+	if (env->wakeup_fd >= 0)
+	{
+		uint64_t expirations = 0;
+		pal_timer_set_wakeup(env, has_deadline ? &wakeup : NULL);
+		pthread_mutex_unlock(&env->mutex);
+		ssize_t bytes = read(env->wakeup_fd, &expirations, sizeof(expirations));
+		pthread_mutex_lock(&env->mutex);
+		(void)bytes;
+		// The expired timerfd is disarmed, unless another thread armed it again meanwhile
+		env->armed_time.tv_sec	= 0;
+		env->armed_time.tv_nsec = 0;
+	}
+	else if (has_deadline)
 	{
-		prev = cur;
-		cur	 = cur->next;
+		pthread_cond_timedwait(&env->cond, &env->mutex, &wakeup);
 	}
+	else
+	{
+		pthread_cond_wait(&env->cond, &env->mutex);
+	}
+	env->wakeups++;
+	if (has_deadline && pal_os_timer_time_cmp(&wakeup, &deadline) < 0)
+	{
+		struct timespec current_time;
+		clock_gettime(CLOCK_MONOTONIC, &current_time);
+		// Only the wakeup scheduled for the spin window spins, an earlier one computes its deadlines again
+		if (pal_os_timer_time_cmp(&current_time, &wakeup) >= 0)
+		{
+			pthread_mutex_unlock(&env->mutex);
+			while (pal_os_timer_time_cmp(&current_time, &deadline) < 0)
+			{
+				pal_cpu_relax();
+				clock_gettime(CLOCK_MONOTONIC, &current_time);
+			}
+			pthread_mutex_lock(&env->mutex);
+		}
+	}
+}
 
-	if (cur)
+/**
+ * @brief Queue a timer by its expiry time in the structure of its backend.
+ * @param[in] timer Pointer to the timer, with its expiry time set.
+ * @param[in] now Current time.
+ * @return 0 on success, or -1 on failure.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_schedule(pal_timer_t *timer, const struct timespec *now)
+{
+	int ret_code = 0;
+	if (PAL_TIMER_BACKEND_HEAP == timer->backend && PAL_TIMER_QUEUE_HEAP == timer->queue)
 	{
-		if (prev)
+		pal_os_timer_heap_update(timer);
+	}
+	else
+	{
+		pal_timer_unqueue(timer);
+		if (PAL_TIMER_BACKEND_WHEEL == timer->backend)
 		{
-			prev->next = cur->next;
+			pal_os_timer_wheel_insert(timer, now);
 		}
 		else
 		{
-			pal_timer_environment.timer_list = cur->next;
+			ret_code = pal_os_timer_heap_insert(timer);
 		}
 	}
+	timer->is_started = 0 == ret_code;
+	pal_timer_wake_service(pal_timer_env(timer));
+	return ret_code;
+}
+
+/**
+ * @brief Compute the expiry time of a timer from now and its period, and schedule it.
+ * @param[in] timer Pointer to the timer.
+ * @return 0 on success, or -1 on failure.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_arm(pal_timer_t *timer)
+{
+	struct timespec current_time;
+	clock_gettime(CLOCK_MONOTONIC, &current_time);
+	pal_os_timer_from_ns(pal_os_timer_ns(&current_time) + PAL_TIMER_US_TO_NS(timer->period_us), &timer->expiry_time);
+	timer->overruns = 0;
+	return pal_timer_schedule(timer, &current_time);
+}
+
+/**
+ * @brief Schedule the next period of a due periodic timer from its previous expiry time.
+ * @param[in] timer Pointer to the timer.
+ * @param[in] now Current time.
+ * @return 0 on success, or -1 on failure.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_rearm(pal_timer_t *timer, const struct timespec *now)
+{
+	uint64_t expiry = pal_os_timer_ns(&timer->expiry_time);
+	uint64_t period = PAL_TIMER_US_TO_NS(timer->period_us);
+	uint64_t now_ns = pal_os_timer_ns(now);
+	// Periods whose expiry also passed while the timer waited to fire
+	uint64_t missed = now_ns > expiry ? (now_ns - expiry) / period : 0;
+	switch (timer->overrun_policy)
+	{
+		case PAL_TIMER_OVERRUN_CATCH_UP:
+			// A next expiry still in the past fires again right away and is counted then, so each missed period counts once
+			timer->overruns += missed ? 1 : 0;
+			expiry += period;
+			break;
+		case PAL_TIMER_OVERRUN_COALESCE:
+			timer->overruns += missed;
+			expiry = missed ? now_ns + period : expiry + period;
+			break;
+		default:
+			timer->overruns += missed;
+			expiry += (missed + 1) * period;
+			break;
+	}
+	pal_os_timer_from_ns(expiry, &timer->expiry_time);
+	return pal_timer_schedule(timer, now);
 }
 
-void *pal_timer_thread_fn(void *arg)
+/**
+ * @brief Unschedule a timer.
+ * @param[in] timer Pointer to the timer.
+ * @note The caller must hold the environment mutex.
+ */
+static void pal_timer_disarm(pal_timer_t *timer)
 {
-	(void)arg;
+	pal_timer_unqueue(timer);
+	timer->is_started = 0;
+	pal_timer_wake_service(pal_timer_env(timer));
+}
 
-	while (1)
+/**
+ * @brief Append a timer to the list of timers waiting for a pool worker.
+ * @param[in] timer Pointer to the timer, which must not be in the list.
+ */
+static void pal_timer_pool_push(pal_timer_t *timer)
+{
+	pal_timer_env_t *env   = pal_timer_env(timer);
+	timer->dispatch_next   = NULL;
+	timer->dispatch_queued = 1;
+	if (env->pool_tail)
+	{
+		env->pool_tail->dispatch_next = timer;
+	}
+	else
 	{
-		pthread_mutex_lock(&pal_timer_environment.mutex);
+		env->pool_head = timer;
+	}
+	env->pool_tail = timer;
+	pthread_cond_signal(&env->pool_cond);
+}
 
-		// Check if the timer list is empty or if the shutdown flag is set
-		while (NULL == pal_timer_environment.timer_list && !pal_timer_environment.shutdown_flag)
+/**
+ * @brief Remove a timer from the list of timers waiting for a pool worker.
+ * @param[in] timer Pointer to the timer. Nothing is done if the timer is not in the list.
+ */
+static void pal_timer_pool_remove(pal_timer_t *timer)
+{
+	pal_timer_env_t *env	  = pal_timer_env(timer);
+	pal_timer_t		*previous = NULL;
+	pal_timer_t		*current  = env->pool_head;
+	while (current && current != timer)
+	{
+		previous = current;
+		current	 = current->dispatch_next;
+	}
+	if (current)
+	{
+		if (previous)
+		{
+			previous->dispatch_next = timer->dispatch_next;
+		}
+		else
 		{
-			pthread_cond_wait(&pal_timer_environment.cond, &pal_timer_environment.mutex);
+			env->pool_head = timer->dispatch_next;
 		}
+		if (env->pool_tail == timer)
+		{
+			env->pool_tail = previous;
+		}
+		timer->dispatch_next   = NULL;
+		timer->dispatch_queued = 0;
+	}
+}
+
+/**
+ * @brief Run the callback of a timer for its pending expirations.
+ * @param[in] timer Pointer to the timer, with at least one pending expiration.
+ * @note A serialized timer runs every expiration that arrives meanwhile, a concurrent one runs a single expiration.
+ * The caller must hold the environment mutex, which is released while the callback runs.
+ */
+static void pal_timer_run_pending(pal_timer_t *timer)
+{
+	pal_timer_env_t *env	  = pal_timer_env(timer);
+	pal_timer_t		*previous = pal_timer_running;
+	pal_timer_running		  = timer;
+	timer->dispatch_running++;
+	do
+	{
+		void (*callback)(struct pal_timer_s *) = timer->callback;
+		void *callback_arg					   = timer->arg;
+		timer->dispatch_pending--;
+		pthread_mutex_unlock(&env->mutex);
+		callback(callback_arg);
+		pthread_mutex_lock(&env->mutex);
+	} while (!timer->concurrent && timer->dispatch_pending);
+	timer->dispatch_running--;
+	pal_timer_running = previous;
+	pthread_cond_broadcast(&env->idle_cond);
+}
 
-		// Kill the thread if the shutdown flag is set
-		if (pal_timer_environment.shutdown_flag)
+/**
+ * @brief Hand an expiration of a timer to its pool or queue.
+ * @param[in] timer Pointer to the due timer.
+ * @note The caller must hold the environment mutex.
+ */
+static void pal_timer_dispatch(pal_timer_t *timer)
+{
+	timer->dispatch_pending++;
+	// A serialized timer already waiting or running picks the expiration up when its current run ends
+	if (timer->concurrent || (!timer->dispatch_queued && 0 == timer->dispatch_running))
+	{
+		if (PAL_TIMER_DISPATCH_POOL == timer->dispatch)
 		{
-			pthread_mutex_unlock(&pal_timer_environment.mutex);
-			break;
+			if (!timer->dispatch_queued)
+			{
+				pal_timer_pool_push(timer);
+			}
 		}
+		else
+		{
+			pal_timer_t *item = timer;
+			if (0 == pal_queue_enqueue(timer->dispatch_queue, &item, PAL_OS_NO_TIMEOUT))
+			{
+				timer->dispatch_queued = 1;
+			}
+			else
+			{
+				timer->dispatch_pending--;
+				timer->overruns++;
+			}
+		}
+	}
+}
 
-		struct timespec current_time;
-		clock_gettime(CLOCK_MONOTONIC, &current_time);
+/**
+ * @brief Pool worker thread function.
+ * @param[in] arg Pointer to the shard the worker belongs to.
+ * @return NULL.
+ */
+static void *pal_timer_worker_fn(void *arg)
+{
+	pal_timer_env_t *env = arg;
 
-		// Check the first timer in the list (the one that expires first)
-		pal_timer_t *timer = pal_timer_environment.timer_list;
+	pthread_mutex_lock(&env->mutex);
+	while (!env->shutdown_flag)
+	{
+		pal_timer_t *timer = env->pool_head;
+		if (NULL == timer)
+		{
+			pthread_cond_wait(&env->pool_cond, &env->mutex);
+		}
+		else
+		{
+			env->pool_head = timer->dispatch_next;
+			if (NULL == env->pool_head)
+			{
+				env->pool_tail = NULL;
+			}
+			timer->dispatch_next   = NULL;
+			timer->dispatch_queued = 0;
+			// The other expirations of a concurrent timer can start on another worker right away
+			if (timer->concurrent && timer->dispatch_pending > 1)
+			{
+				pal_timer_pool_push(timer);
+			}
+			pal_timer_run_pending(timer);
+		}
+	}
+	pthread_mutex_unlock(&env->mutex);
+	return NULL;
+}
+
+/**
+ * @brief Start the pool workers of a shard that are not running yet.
+ * @param[in] env Pointer to the shard.
+ * @return 0 if at least one worker is running, or -1 on failure.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_pool_start(pal_timer_env_t *env)
+{
+	while (env->pool_size < PAL_TIMER_POOL_WORKERS && 0 == pthread_create(&env->pool[env->pool_size], NULL, pal_timer_worker_fn, env))
+	{
+		env->pool_size++;
+	}
+	return env->pool_size ? 0 : -1;
+}
 
-		// Check if a timer has already expired
-		int already_expired = pal_os_timer_time_cmp(&timer->expiry_time, &current_time) <= 0;
-		int wait_result		= 0;
-		// Wait for the timer to expire or for a shutdown signal
-		if (!already_expired)
+/**
+ * @brief Lock two shards in index order.
+ * @param[in] first Pointer to the first shard.
+ * @param[in] second Pointer to the second shard, which may be the first one.
+ */
+static void pal_timer_lock_shards(pal_timer_env_t *first, pal_timer_env_t *second)
+{
+	pthread_mutex_lock(first < second ? &first->mutex : &second->mutex);
+	if (first != second)
+	{
+		pthread_mutex_lock(first < second ? &second->mutex : &first->mutex);
+	}
+}
+
+/**
+ * @brief Unlock two shards locked with pal_timer_lock_shards.
+ * @param[in] first Pointer to the first shard.
+ * @param[in] second Pointer to the second shard, which may be the first one.
+ */
+static void pal_timer_unlock_shards(pal_timer_env_t *first, pal_timer_env_t *second)
+{
+	pthread_mutex_unlock(&first->mutex);
+	if (first != second)
+	{
+		pthread_mutex_unlock(&second->mutex);
+	}
+}
+
+/**
+ * @brief Move an idle timer to a shard.
+ * @param[in] timer Pointer to the timer.
+ * @param[in] shard Index of the shard.
+ * @return 0 on success, or -1 if the timer is started, has a callback pending or running, or is a pool timer and the pool of the shard
+ * cannot start.
+ * @note Both shards stay locked from the idle check to the move, so a concurrent start cannot leave the timer on its old shard.
+ */
+static int pal_timer_move(pal_timer_t *timer, size_t shard)
+{
+	int				 ret_code = -1;
+	pal_timer_env_t *to		  = &pal_timer_environment[shard];
+	pal_timer_env_t *from	  = NULL;
+	// The timer may move again before both locks are held
+	do
+	{
+		if (from)
 		{
-			wait_result = pthread_cond_timedwait(&pal_timer_environment.cond, &pal_timer_environment.mutex, &timer->expiry_time);
+			pal_timer_unlock_shards(from, to);
 		}
+		from = &pal_timer_environment[pal_atomic_size_load(&timer->shard, PAL_ATOMIC_RELAXED)];
+		pal_timer_lock_shards(from, to);
+	} while (from != &pal_timer_environment[pal_atomic_size_load(&timer->shard, PAL_ATOMIC_RELAXED)]);
+	int idle = !timer->is_started && 0 == timer->dispatch_running && 0 == timer->dispatch_pending && !timer->dispatch_queued;
+	// The pool of the new shard must run before a pool timer can expire there
+	if (idle && (PAL_TIMER_DISPATCH_POOL != timer->dispatch || 0 == pal_timer_pool_start(to)))
+	{
+		pal_atomic_size_store(&timer->shard, shard, PAL_ATOMIC_RELAXED);
+		timer->shard_set = 1;
+		ret_code		 = 0;
+	}
+	pal_timer_unlock_shards(from, to);
+	return ret_code;
+}
 
-		// If the wait timed out, check if the timer has expired
-		if (already_expired || wait_result == ETIMEDOUT)
+/**
+ * @brief Reschedule or unschedule a due timer and hand its expiration to the context running its callback.
+ * @param[in] timer Pointer to the due timer.
+ * @param[in] now Current time.
+ * @return Non-zero if the callback runs on the service thread, with the expiration left pending for it.
+ * @note The caller must hold the environment mutex.
+ */
+static int pal_timer_expire(pal_timer_t *timer, const struct timespec *now)
+{
+	int inline_call = PAL_TIMER_DISPATCH_SERVICE == timer->dispatch;
+	// Periodic timers are rescheduled from their expiry so the callback runtime does not drift them, one-shot timers are unscheduled
+	if (timer->is_periodic)
+	{
+		pal_timer_rearm(timer, now);
+	}
+	else
+	{
+		pal_timer_disarm(timer);
+	}
+	if (inline_call)
+	{
+		timer->dispatch_pending++;
+	}
+	else
+	{
+		pal_timer_dispatch(timer);
+	}
+	return inline_call;
+}
+
+/**
+ * @brief Remove a timer from the batch of callbacks the service thread has yet to run.
+ * @param[in] timer Pointer to the timer. Nothing is done if the timer is not in the batch.
+ * @note The caller must hold the environment mutex.
+ */
+static void pal_timer_batch_remove(pal_timer_t *timer)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	for (size_t index = 0; index < env->batch_size; index++)
+	{
+		if (env->batch[index] == timer)
 		{
-			// Execute timer callback if the timer has expired
-			if (pal_os_timer_time_cmp(&timer->expiry_time, &current_time) <= 0)
-			{
-				// Call the timer callback function
-				timer->callback(timer->arg);
+			env->batch[index] = NULL;
+		}
+	}
+}
 
-				// If the timer is periodic, reset its expiry time and reinsert it into the list
-				if (timer->is_periodic)
+/**
+ * @brief Start the timer thread of a shard.
+ * @param[in] env Pointer to the shard.
+ * @param[in] shard Index of the shard.
+ * @return 0 on success, or -1 on failure.
+ */
+static int pal_timer_shard_init(pal_timer_env_t *env, size_t shard)
+{
+	int				   ret_code = -1;
+	pthread_condattr_t cond_attr;
+	pthread_attr_t	   thread_attr;
+	// Expiry times are CLOCK_MONOTONIC, a condition variable on the default CLOCK_REALTIME would misread them
+	if (0 == pthread_condattr_init(&cond_attr))
+	{
+		pthread_condattr_setclock(&cond_attr, CLOCK_MONOTONIC);
+		pthread_cond_destroy(&env->cond);
+		pthread_cond_init(&env->cond, &cond_attr);
+		pthread_condattr_destroy(&cond_attr);
+	}
+	if (env->use_timerfd)
+	{
+		// Without a timerfd the thread falls back to the condition variable
+		env->wakeup_fd			= timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+		env->armed_time.tv_sec	= 0;
+		env->armed_time.tv_nsec = 0;
+	}
+	if (0 == pthread_attr_init(&thread_attr))
+	{
+		cpu_set_t allowed;
+		if (pal_timer_shard_count > 1 && 0 == sched_getaffinity(0, sizeof(allowed), &allowed))
+		{
+			// The thread of a shard runs on the CPUs whose timers it serves, next to the data of their callbacks
+			cpu_set_t cpus;
+			CPU_ZERO(&cpus);
+			for (size_t cpu = 0; cpu < CPU_SETSIZE; cpu++)
+			{
+				if (CPU_ISSET(cpu, &allowed) && shard == cpu % pal_timer_shard_count)
 				{
-					// Add the period to the expiry time
-					pal_timer_restart(timer);
+					CPU_SET(cpu, &cpus);
 				}
-				else
+			}
+			if (CPU_COUNT(&cpus))
+			{
+				pthread_attr_setaffinity_np(&thread_attr, sizeof(cpus), &cpus);
+			}
+		}
+		if (0 == pthread_create(&env->thread_handle, &thread_attr, pal_timer_thread_fn, env))
+		{
+			ret_code = 0;
+		}
+		pthread_attr_destroy(&thread_attr);
+	}
+	if (0 != ret_code && env->wakeup_fd >= 0)
+	{
+		close(env->wakeup_fd);
+		env->wakeup_fd = -1;
+	}
+	return ret_code;
+}
+
+/**
+ * @brief Detach a timer dropped by a shard deinit from the structures of the shard.
+ * @param[in] timer Pointer to the timer.
+ */
+static void pal_timer_drop(pal_timer_t *timer)
+{
+	timer->queue	  = PAL_TIMER_QUEUE_NONE;
+	timer->prev		  = NULL;
+	timer->next		  = NULL;
+	timer->is_started = 0;
+}
+
+/**
+ * @brief Stop the threads of a shard and drop its scheduled timers.
+ * @param[in] env Pointer to the shard.
+ */
+static void pal_timer_shard_deinit(pal_timer_env_t *env)
+{
+	if (env->thread_handle || env->pool_size)
+	{
+		pthread_mutex_lock(&env->mutex);
+		env->shutdown_flag = 1;
+		if (env->wakeup_fd >= 0)
+		{
+			struct timespec now = {0, 1};
+			pal_timer_set_wakeup(env, &now);
+		}
+		pthread_cond_signal(&env->cond);
+		pthread_cond_broadcast(&env->pool_cond);
+		pthread_mutex_unlock(&env->mutex);
+		if (env->thread_handle)
+		{
+			pthread_join(env->thread_handle, NULL);
+			env->thread_handle = 0;
+		}
+		for (size_t worker = 0; worker < env->pool_size; worker++)
+		{
+			pthread_join(env->pool[worker], NULL);
+		}
+		env->pool_size	   = 0;
+		env->shutdown_flag = 0;
+	}
+	if (env->wakeup_fd >= 0)
+	{
+		close(env->wakeup_fd);
+		env->wakeup_fd = -1;
+	}
+	pthread_mutex_lock(&env->mutex);
+	// The dropped timers must not keep links into the cleared structures, a later stop or delete would follow them
+	for (size_t index = 0; index < env->heap_size; index++)
+	{
+		pal_timer_drop(env->heap[index]);
+	}
+	free(env->heap);
+	env->heap		   = NULL;
+	env->heap_size	   = 0;
+	env->heap_capacity = 0;
+	for (size_t slot = 0; slot < PAL_TIMER_WHEEL_SLOTS; slot++)
+	{
+		while (env->wheel[slot])
+		{
+			pal_timer_t *timer = env->wheel[slot];
+			env->wheel[slot]   = timer->next;
+			pal_timer_drop(timer);
+		}
+	}
+	env->wheel_size = 0;
+	while (env->expired_head)
+	{
+		pal_timer_t *timer = env->expired_head;
+		env->expired_head  = timer->next;
+		pal_timer_drop(timer);
+	}
+	env->expired_tail = NULL;
+	env->batch_size	  = 0;
+	while (env->pool_head)
+	{
+		pal_timer_t *timer	   = env->pool_head;
+		env->pool_head		   = timer->dispatch_next;
+		timer->dispatch_next   = NULL;
+		timer->dispatch_queued = 0;
+	}
+	env->pool_tail = NULL;
+	pthread_mutex_unlock(&env->mutex);
+}
+
+/* ---------------------------------------------------------------------------
+ * Function Implementations
+ * ---------------------------------------------------------------------------
+ */
+int pal_timer_init(void)
+{
+	int ret_code = 0;
+	for (size_t shard = 0; shard < pal_timer_shard_count && 0 == ret_code; shard++)
+	{
+		ret_code = pal_timer_shard_init(&pal_timer_environment[shard], shard);
+	}
+	if (0 != ret_code)
+	{
+		pal_timer_deinit();
+	}
+	return ret_code;
+}
+
+void pal_timer_deinit(void)
+{
+	for (size_t shard = 0; shard < PAL_TIMER_MAX_SHARDS; shard++)
+	{
+		pal_timer_shard_deinit(&pal_timer_environment[shard]);
+	}
+}
+
+int pal_os_timer_time_cmp(const struct timespec *a, const struct timespec *b)
+{
+	int result = 0;
+	if (a->tv_sec == b->tv_sec)
+	{
+		result = a->tv_nsec - b->tv_nsec;
+	}
+	else
+	{
+		result = a->tv_sec - b->tv_sec;
+	}
+	return result;
+}
+
+int pal_os_timer_heap_insert(pal_timer_t *timer)
+{
+	pal_timer_env_t *env	  = pal_timer_env(timer);
+	int				 ret_code = 0;
+	if (env->heap_size == env->heap_capacity)
+	{
+		size_t		  capacity = env->heap_capacity ? 2 * env->heap_capacity : PAL_TIMER_HEAP_INITIAL_CAPACITY;
+		pal_timer_t **heap	   = realloc(env->heap, capacity * sizeof(*heap));
+		if (heap)
+		{
+			env->heap		   = heap;
+			env->heap_capacity = capacity;
+		}
+		else
+		{
+			ret_code = -1;
+		}
+	}
+	if (0 == ret_code)
+	{
+		pal_os_timer_from_ns(pal_os_timer_ns(&timer->expiry_time) + PAL_TIMER_MS_TO_NS(timer->slack_ms), &timer->latest_time);
+		timer->heap_index = env->heap_size++;
+		timer->queue	  = PAL_TIMER_QUEUE_HEAP;
+		pal_os_timer_heap_sift_up(timer);
+	}
+	return ret_code;
+}
+
+void pal_os_timer_heap_remove(pal_timer_t *timer)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	if (pal_os_timer_heap_contains(timer))
+	{
+		pal_timer_t *last = env->heap[--env->heap_size];
+		if (last != timer)
+		{
+			// The last timer fills the hole and moves to wherever it belongs
+			last->heap_index = timer->heap_index;
+			pal_os_timer_heap_update(last);
+		}
+		timer->heap_index = SIZE_MAX;
+		timer->queue	  = PAL_TIMER_QUEUE_NONE;
+	}
+}
+
+void pal_os_timer_heap_update(pal_timer_t *timer)
+{
+	pal_os_timer_from_ns(pal_os_timer_ns(&timer->expiry_time) + PAL_TIMER_MS_TO_NS(timer->slack_ms), &timer->latest_time);
+	pal_os_timer_heap_sift_up(timer);
+	pal_os_timer_heap_sift_down(timer);
+}
+
+pal_timer_t *pal_os_timer_heap_top(pal_timer_env_t *env) { return env->heap_size ? env->heap[0] : NULL; }
+
+size_t pal_os_timer_heap_expire(pal_timer_env_t *env, const struct timespec *now)
+{
+	size_t		 moved = 0;
+	pal_timer_t *timer = NULL;
+	// Timers leave in order of their latest time, stopping at the first one whose slack window has not opened yet
+	while (NULL != (timer = pal_os_timer_heap_top(env)) && pal_os_timer_time_cmp(&timer->expiry_time, now) <= 0)
+	{
+		pal_os_timer_heap_remove(timer);
+		pal_os_timer_expired_push(timer);
+		moved++;
+	}
+	return moved;
+}
+
+void pal_os_timer_wheel_insert(pal_timer_t *timer, const struct timespec *now)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	if (0 == env->wheel_size)
+	{
+		// An empty wheel restarts from now instead of sweeping the slots of the ticks it was idle for
+		env->wheel_tick = pal_os_timer_ns(now) / PAL_TIMER_WHEEL_TICK_NS;
+	}
+	// Rounding up keeps wheel timers from firing early, a tick already processed is moved to the next one
+	timer->wheel_tick = (pal_os_timer_ns(&timer->expiry_time) + PAL_TIMER_WHEEL_TICK_NS - 1) / PAL_TIMER_WHEEL_TICK_NS;
+	if (timer->wheel_tick <= env->wheel_tick)
+	{
+		timer->wheel_tick = env->wheel_tick + 1;
+	}
+	struct pal_timer_s **slot = &env->wheel[timer->wheel_tick % PAL_TIMER_WHEEL_SLOTS];
+	timer->prev				  = NULL;
+	timer->next				  = *slot;
+	if (*slot)
+	{
+		(*slot)->prev = timer;
+	}
+	*slot		 = timer;
+	timer->queue = PAL_TIMER_QUEUE_WHEEL;
+	env->wheel_size++;
+}
+
+void pal_os_timer_wheel_remove(pal_timer_t *timer)
+{
+	pal_timer_env_t *env = pal_timer_env(timer);
+	if (PAL_TIMER_QUEUE_WHEEL == timer->queue)
+	{
+		pal_os_timer_list_unlink(&env->wheel[timer->wheel_tick % PAL_TIMER_WHEEL_SLOTS], NULL, timer);
+		timer->queue = PAL_TIMER_QUEUE_NONE;
+		env->wheel_size--;
+	}
+}
+
+size_t pal_os_timer_wheel_advance(pal_timer_env_t *env, const struct timespec *now)
+{
+	size_t	 moved	  = 0;
+	uint64_t now_tick = pal_os_timer_ns(now) / PAL_TIMER_WHEEL_TICK_NS;
+	if (env->wheel_size && now_tick > env->wheel_tick)
+	{
+		// Timers carry their absolute tick, so visiting each slot once covers any number of elapsed ticks
+		uint64_t ticks = now_tick - env->wheel_tick;
+		if (ticks > PAL_TIMER_WHEEL_SLOTS)
+		{
+			ticks = PAL_TIMER_WHEEL_SLOTS;
+		}
+		for (uint64_t tick = now_tick - ticks + 1; tick <= now_tick; tick++)
+		{
+			struct pal_timer_s **slot  = &env->wheel[tick % PAL_TIMER_WHEEL_SLOTS];
+			pal_timer_t			*timer = *slot;
+			while (timer)
+			{
+				pal_timer_t *next = timer->next;
+				if (timer->wheel_tick <= now_tick)
 				{
-					// Remove the timer from the list if it is one-shot
-					pal_os_timer_remove(timer);
-					pthread_mutex_unlock(&pal_timer_environment.mutex);
+					// The whole bucket is drained in this pass, later rounds sharing the slot stay
+					pal_os_timer_list_unlink(slot, NULL, timer);
+					env->wheel_size--;
+					pal_os_timer_expired_push(timer);
+					moved++;
 				}
+				timer = next;
 			}
 		}
-		else
+	}
+	if (now_tick > env->wheel_tick)
+	{
+		env->wheel_tick = now_tick;
+	}
+	return moved;
+}
+
+pal_timer_t *pal_os_timer_expired_pop(pal_timer_env_t *env)
+{
+	pal_timer_t *timer = env->expired_head;
+	if (timer)
+	{
+		pal_os_timer_list_unlink(&env->expired_head, &env->expired_tail, timer);
+		timer->queue = PAL_TIMER_QUEUE_NONE;
+	}
+	return timer;
+}
+
+void *pal_timer_thread_fn(void *arg)
+{
+	pal_timer_env_t *env = arg;
+
+	// The default timer slack of a thread delays every kernel wakeup by up to 50 us, too much for sub-millisecond periods
+	prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+	pthread_mutex_lock(&env->mutex);
+	while (!env->shutdown_flag)
+	{
+		// Every timer due at one clock sample joins the expired list, which is handled in bounded batches
+		struct timespec current_time;
+		clock_gettime(CLOCK_MONOTONIC, &current_time);
+		pal_os_timer_wheel_advance(env, &current_time);
+		pal_os_timer_heap_expire(env, &current_time);
+		size_t		 handled = 0;
+		pal_timer_t *timer	 = NULL;
+		while (handled < PAL_TIMER_BATCH_MAX && NULL != (timer = pal_os_timer_expired_pop(env)))
+		{
+			if (pal_timer_expire(timer, &current_time))
+			{
+				env->batch[env->batch_size++] = timer;
+			}
+			handled++;
+		}
+		if (handled)
 		{
-			// If the wait was interrupted, check if the shutdown flag is set
-			if (pal_timer_environment.shutdown_flag)
+			// The callbacks run unlocked, so they can use the timer API, and a timer stopped meanwhile has left the batch
+			for (size_t index = 0; index < env->batch_size; index++)
 			{
-				pthread_mutex_unlock(&pal_timer_environment.mutex);
-				break;
+				timer = env->batch[index];
+				if (timer)
+				{
+					env->batch[index] = NULL;
+					pal_timer_run_pending(timer);
+				}
 			}
+			env->batch_size = 0;
+		}
+		else
+		{
+			pal_timer_wait(env);
 		}
-		pthread_mutex_unlock(&pal_timer_environment.mutex);
 	}
+	pthread_mutex_unlock(&env->mutex);
 	return NULL;
 }
 
 int pal_timer_create(pal_timer_t *timer, const char *name, pal_timer_type_t type, size_t period, pal_timer_callback_t callback, int auto_start, void *arg)
+{
+	int ret_code = -1;
+	// The period is kept in microseconds, a longer one would wrap around on 32-bit targets
+	if (period <= SIZE_MAX / 1000)
+	{
+		ret_code = pal_timer_create_us(timer, name, type, period * 1000, callback, auto_start, arg);
+	}
+	return ret_code;
+}
+
+int pal_timer_create_us(pal_timer_t *timer, const char *name, pal_timer_type_t type, size_t period_us, pal_timer_callback_t callback, int auto_start, void *arg)
 {
 	int ret_code = -1;
 	(void)name;
-	if (timer && callback && period)
+	if (timer && callback && period_us)
 	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		if (!timer->shard_set)
+		{
+			// A new timer is served by the shard of the CPU creating it, it stays on its shard if it cannot move there
+			pthread_mutex_unlock(&env->mutex);
+			pal_timer_move(timer, pal_timer_cpu_shard());
+			env = pal_timer_lock(timer);
+		}
 		timer->callback	   = callback;
 		timer->arg		   = arg;
 		timer->is_periodic = (type == PAL_TIMER_TYPE_PERIODIC);
-		timer->period_ms   = period;
-		if (auto_start)
+		timer->period_us   = period_us;
+		ret_code		   = 0;
+		if (auto_start && !timer->is_started)
 		{
-			pal_timer_start(timer);
+			ret_code = pal_timer_arm(timer);
 		}
-		pthread_cond_signal(&pal_timer_environment.cond);
-		ret_code = 0;
+		pthread_mutex_unlock(&env->mutex);
 	}
 	return ret_code;
 }
@@ -234,117 +1229,230 @@ int pal_timer_create(pal_timer_t *timer, const char *name, pal_timer_type_t type
 int pal_timer_start(pal_timer_t *timer)
 {
 	int ret_code = -1;
-	if (timer && !timer->is_started)
+	if (timer)
 	{
-		struct timespec current_time;
-		clock_gettime(CLOCK_MONOTONIC, &current_time);
-		timer->expiry_time.tv_sec  = current_time.tv_sec + timer->period_ms / 1000;
-		timer->expiry_time.tv_nsec = current_time.tv_nsec + (timer->period_ms % 1000) * 1000000;
-		if (timer->expiry_time.tv_nsec >= 1000000000)
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		if (!timer->is_started)
 		{
-			timer->expiry_time.tv_sec++;
-			timer->expiry_time.tv_nsec -= 1000000000;
+			ret_code = pal_timer_arm(timer);
 		}
-		pal_os_timer_insert_sorted(timer);
-		timer->is_started = 1;
-		pthread_cond_signal(&pal_timer_environment.cond);
+		pthread_mutex_unlock(&env->mutex);
+	}
+	return ret_code;
+}
+
+int pal_timer_start_from_isr(pal_timer_t *timer) { return pal_timer_start(timer); }
+
+int pal_timer_stop(pal_timer_t *timer)
+{
+	int ret_code = -1;
+	if (timer)
+	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		pal_timer_disarm(timer);
+		// Expirations not handed to a callback yet are dropped, a stale queue entry finds nothing to run
+		timer->dispatch_pending = 0;
+		pal_timer_pool_remove(timer);
+		pal_timer_batch_remove(timer);
+		pthread_mutex_unlock(&env->mutex);
 		ret_code = 0;
 	}
 	return ret_code;
 }
 
-int pal_timer_start_from_isr(pal_timer_t *timer)
+int pal_timer_stop_from_isr(pal_timer_t *timer) { return pal_timer_stop(timer); }
+
+int pal_timer_restart(pal_timer_t *timer)
 {
 	int ret_code = -1;
-	if (timer && !timer->is_started)
+	if (timer)
 	{
-		struct timespec current_time;
-		clock_gettime(CLOCK_MONOTONIC, &current_time);
-		timer->expiry_time.tv_sec  = current_time.tv_sec + timer->period_ms / 1000;
-		timer->expiry_time.tv_nsec = current_time.tv_nsec + (timer->period_ms % 1000) * 1000000;
-		if (timer->expiry_time.tv_nsec >= 1000000000)
+		// A started timer is rescheduled in place instead of being removed and inserted again
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		ret_code			 = pal_timer_arm(timer);
+		pthread_mutex_unlock(&env->mutex);
+	}
+	return ret_code;
+}
+
+int pal_timer_restart_from_isr(pal_timer_t *timer) { return pal_timer_restart(timer); }
+
+int pal_timer_change_period(pal_timer_t *timer, size_t new_period)
+{
+	int ret_code = -1;
+	if (new_period <= SIZE_MAX / 1000)
+	{
+		ret_code = pal_timer_change_period_us(timer, new_period * 1000);
+	}
+	return ret_code;
+}
+
+int pal_timer_change_period_from_isr(pal_timer_t *timer, size_t new_period) { return pal_timer_change_period(timer, new_period); }
+
+int pal_timer_change_period_us(pal_timer_t *timer, size_t new_period_us)
+{
+	int ret_code = -1;
+	if (timer && new_period_us)
+	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		timer->period_us	 = new_period_us;
+		ret_code			 = pal_timer_arm(timer);
+		pthread_mutex_unlock(&env->mutex);
+	}
+	return ret_code;
+}
+
+size_t pal_timer_get_resolution_us(void)
+{
+	size_t			resolution = 1;
+	struct timespec res;
+	if (0 == clock_getres(CLOCK_MONOTONIC, &res))
+	{
+		uint64_t res_ns = pal_os_timer_ns(&res);
+		if (res_ns > 1000)
 		{
-			timer->expiry_time.tv_sec++;
-			timer->expiry_time.tv_nsec -= 1000000000;
+			resolution = (size_t)((res_ns + 999) / 1000);
 		}
-		pal_os_timer_insert_sorted(timer);
-		timer->is_started = 1;
-		pthread_cond_signal(&pal_timer_environment.cond);
-		ret_code = 0;
+	}
+	return resolution;
+}
+
+int pal_timer_set_backend(pal_timer_t *timer, pal_timer_backend_t backend)
+{
+	int ret_code = -1;
+	if (timer && (PAL_TIMER_BACKEND_HEAP == backend || PAL_TIMER_BACKEND_WHEEL == backend))
+	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		if (!timer->is_started)
+		{
+			timer->backend = backend;
+			ret_code	   = 0;
+		}
+		pthread_mutex_unlock(&env->mutex);
 	}
 	return ret_code;
 }
 
-int pal_timer_stop(pal_timer_t *timer)
+int pal_timer_set_slack(pal_timer_t *timer, size_t slack_ms)
 {
 	int ret_code = -1;
 	if (timer)
 	{
-		pal_os_timer_remove(timer);
-		timer->is_started = 0;
-		pthread_cond_signal(&pal_timer_environment.cond);
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		timer->slack_ms		 = slack_ms;
+		if (PAL_TIMER_QUEUE_HEAP == timer->queue)
+		{
+			pal_os_timer_heap_update(timer);
+			pal_timer_wake_service(env);
+		}
+		pthread_mutex_unlock(&env->mutex);
 		ret_code = 0;
 	}
 	return ret_code;
 }
 
-int pal_timer_stop_from_isr(pal_timer_t *timer)
+int pal_timer_set_spin(pal_timer_t *timer, size_t spin_us)
 {
 	int ret_code = -1;
 	if (timer)
 	{
-		pal_os_timer_remove(timer);
-		timer->is_started = 0;
-		pthread_cond_signal(&pal_timer_environment.cond);
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		timer->spin_us		 = spin_us;
+		if (PAL_TIMER_QUEUE_HEAP == timer->queue)
+		{
+			pal_timer_wake_service(env);
+		}
+		pthread_mutex_unlock(&env->mutex);
 		ret_code = 0;
 	}
 	return ret_code;
 }
 
-int pal_timer_restart(pal_timer_t *timer)
+int pal_timer_set_overrun_policy(pal_timer_t *timer, pal_timer_overrun_policy_t policy)
 {
 	int ret_code = -1;
-	if (timer)
+	if (timer && (PAL_TIMER_OVERRUN_SKIP == policy || PAL_TIMER_OVERRUN_CATCH_UP == policy || PAL_TIMER_OVERRUN_COALESCE == policy))
 	{
-		pal_timer_stop(timer);
-		pal_timer_start(timer);
+		pal_timer_env_t *env  = pal_timer_lock(timer);
+		timer->overrun_policy = policy;
+		pthread_mutex_unlock(&env->mutex);
 		ret_code = 0;
 	}
 	return ret_code;
 }
 
-int pal_timer_restart_from_isr(pal_timer_t *timer)
+size_t pal_timer_get_overruns(pal_timer_t *timer)
+{
+	size_t overruns = 0;
+	if (timer)
+	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		overruns			 = timer->overruns;
+		pthread_mutex_unlock(&env->mutex);
+	}
+	return overruns;
+}
+
+int pal_timer_set_dispatch(pal_timer_t *timer, pal_timer_dispatch_t dispatch, pal_queue_t *queue, int concurrent)
+{
+	int ret_code = -1;
+	if (timer && (PAL_TIMER_DISPATCH_SERVICE == dispatch || PAL_TIMER_DISPATCH_POOL == dispatch || (PAL_TIMER_DISPATCH_QUEUE == dispatch && queue)))
+	{
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		if (!timer->is_started && (PAL_TIMER_DISPATCH_POOL != dispatch || 0 == pal_timer_pool_start(env)))
+		{
+			timer->dispatch		  = dispatch;
+			timer->dispatch_queue = queue;
+			timer->concurrent	  = concurrent;
+			ret_code			  = 0;
+		}
+		pthread_mutex_unlock(&env->mutex);
+	}
+	return ret_code;
+}
+
+int pal_timer_run_dispatched(pal_timer_t *timer)
 {
 	int ret_code = -1;
 	if (timer)
 	{
-		pal_timer_stop(timer);
-		pal_timer_start(timer);
-		ret_code = 0;
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		if (PAL_TIMER_DISPATCH_QUEUE == timer->dispatch)
+		{
+			if (!timer->concurrent)
+			{
+				timer->dispatch_queued = 0;
+			}
+			// A serialized timer running on another consumer already runs this expiration
+			if (timer->dispatch_pending && (timer->concurrent || 0 == timer->dispatch_running))
+			{
+				pal_timer_run_pending(timer);
+			}
+			ret_code = 0;
+		}
+		pthread_mutex_unlock(&env->mutex);
 	}
 	return ret_code;
 }
 
-int pal_timer_change_period(pal_timer_t *timer, size_t new_period)
+int pal_timer_set_shards(size_t count)
 {
 	int ret_code = -1;
-	if (timer && new_period)
+	// Timers keep the shard they were assigned, so the count only changes while the service is stopped
+	if (count && count <= PAL_TIMER_MAX_SHARDS && 0 == pal_timer_environment[0].thread_handle)
 	{
-		timer->period_ms = new_period;
-		pal_timer_restart(timer);
-		ret_code = 0;
+		pal_timer_shard_count = count;
+		ret_code			  = 0;
 	}
 	return ret_code;
 }
 
-int pal_timer_change_period_from_isr(pal_timer_t *timer, size_t new_period)
+int pal_timer_set_shard(pal_timer_t *timer, size_t shard)
 {
 	int ret_code = -1;
-	if (timer && new_period)
+	if (timer && shard < pal_timer_shard_count)
 	{
-		timer->period_ms = new_period;
-		pal_timer_restart(timer);
-		ret_code = 0;
+		ret_code = pal_timer_move(timer, shard);
 	}
 	return ret_code;
 }
@@ -354,7 +1462,9 @@ int pal_is_timer_active(pal_timer_t *timer)
 	int ret_code = 0;
 	if (timer)
 	{
-		ret_code = timer->is_started;
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		ret_code			 = timer->is_started;
+		pthread_mutex_unlock(&env->mutex);
 	}
 	return ret_code;
 }
@@ -365,7 +1475,14 @@ int pal_timer_delete(pal_timer_t *timer)
 	if (timer)
 	{
 		pal_timer_stop(timer);
-		return 0;
+		// A callback deleting its own timer only waits for the other runs
+		pal_timer_env_t *env = pal_timer_lock(timer);
+		while (timer->dispatch_running > (pal_timer_running == timer ? 1u : 0u))
+		{
+			pthread_cond_wait(&env->idle_cond, &env->mutex);
+		}
+		pthread_mutex_unlock(&env->mutex);
+		ret_code = 0;
 	}
 	return ret_code;
-}
\ No newline at end of file
+}
@@ -10,39 +10,78 @@ extern "C"
 // ============================
 #include <pthread.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <time.h>
 
 #include "pal_os/timer.h"
 // ============================
 // Macros and Constants
 // ============================
+#ifndef PAL_TIMER_HEAP_INITIAL_CAPACITY
+#define PAL_TIMER_HEAP_INITIAL_CAPACITY 16	//!< Timers the heap can hold before its storage is first grown
+#endif
+
+#ifndef PAL_TIMER_BATCH_MAX
+#define PAL_TIMER_BATCH_MAX 32	//!< Expired timers the service thread handles per pass before it checks for shutdown and reads the clock again
+#endif
+
+#ifndef PAL_TIMER_USE_TIMERFD
+#define PAL_TIMER_USE_TIMERFD 1  //!< Non-zero to wake the timer thread with a timerfd, zero to wait on a condition variable
+#endif
+
+#define PAL_TIMER_QUEUE_NONE	0  //!< The timer is not scheduled
+#define PAL_TIMER_QUEUE_HEAP	1  //!< The timer is in the timer heap
+#define PAL_TIMER_QUEUE_WHEEL	2  //!< The timer is in a slot of the timing wheel
+#define PAL_TIMER_QUEUE_EXPIRED 3  //!< The timer is due and waits in the expired list for its callback to run
 
 // ============================
 // Type Definitions
 // ============================
 
+/**
+ * @brief Timer service shard: a timer thread with its own timer structures and lock
+ */
 typedef struct pal_timer_env_s
 {
-	pthread_t			thread_handle;	//!< Thread handle for the timer thread
-	pthread_mutex_t		mutex;			//!< Mutex for synchronizing access to the timer list
-	pthread_cond_t		cond;			//!< Condition variable for signaling the timer thread
-	struct pal_timer_s *timer_list;		//!< Pointer to the list of timers
-	int					shutdown_flag;	//!< Flag indicating if the timer thread should shut down
+	pthread_t			 thread_handle;					 //!< Thread handle for the timer thread
+	pthread_mutex_t		 mutex;							 //!< Mutex for synchronizing access to the timer queues
+	pthread_cond_t		 cond;							 //!< Condition variable for signaling the timer thread
+	struct pal_timer_s **heap;							 //!< Started timers, as a binary min-heap ordered by expiry time
+	size_t				 heap_size;						 //!< Number of timers in the heap
+	size_t				 heap_capacity;					 //!< Number of timers the heap storage can hold
+	struct pal_timer_s	*wheel[PAL_TIMER_WHEEL_SLOTS];	 //!< Timers on the timing wheel, one list per slot
+	size_t				 wheel_size;					 //!< Number of timers on the timing wheel
+	uint64_t			 wheel_tick;					 //!< Last wheel tick whose slot was processed
+	struct pal_timer_s	*expired_head;					 //!< First due timer whose callback has not run yet
+	struct pal_timer_s	*expired_tail;					 //!< Last due timer whose callback has not run yet
+	struct pal_timer_s	*batch[PAL_TIMER_BATCH_MAX];	 //!< Due timers of the current pass whose callbacks run on the timer thread, NULL once stopped
+	size_t				 batch_size;					 //!< Number of entries in the batch
+	pthread_t			 pool[PAL_TIMER_POOL_WORKERS];	 //!< Worker threads running the callbacks of timers dispatched to the pool
+	size_t				 pool_size;						 //!< Number of started workers
+	pthread_cond_t		 pool_cond;						 //!< Condition variable for signaling the workers
+	pthread_cond_t		 idle_cond;						 //!< Condition variable signaled when a dispatched callback returns
+	struct pal_timer_s	*pool_head;						 //!< First timer waiting for a worker
+	struct pal_timer_s	*pool_tail;						 //!< Last timer waiting for a worker
+	int					 use_timerfd;					 //!< Non-zero if pal_timer_init arms a timerfd for the earliest deadline
+	int					 wakeup_fd;						 //!< timerfd the timer thread blocks on, or -1 when it waits on the condition variable
+	struct timespec		 armed_time;					 //!< Absolute CLOCK_MONOTONIC time the timerfd is armed for, zero when disarmed
+	size_t				 wakeups;						 //!< Number of times the timer thread returned from waiting
+	int					 shutdown_flag;					 //!< Flag indicating if the timer thread should shut down
 } pal_timer_env_t;
 
-extern pal_timer_env_t pal_timer_environment;  //!< Global timer environment structure
+extern pal_timer_env_t pal_timer_environment[PAL_TIMER_MAX_SHARDS];  //!< Timer service shards, the first pal_timer_set_shards are started
 
 // ============================
 // Function Declarations
 // ============================
 /**
- * @brief Initialize the timer module
+ * @brief Initialize the timer module, starting the thread of every shard
  * @return 0 on success, -1 on failure
  */
 int pal_timer_init(void);
 
 /**
- * @brief Deinitialize the timer module
+ * @brief Deinitialize the timer module, stopping every shard
  */
 void pal_timer_deinit(void);
 
@@ -55,20 +94,79 @@ void pal_timer_deinit(void);
 int pal_os_timer_time_cmp(const struct timespec *a, const struct timespec *b);
 
 /**
- * @brief Insert a timer into the sorted timer list
- * @param timer Pointer to the timer to be inserted
+ * @brief Insert a timer into the timer heap, ordered by its expiry time plus its slack
+ * @param timer Pointer to the timer to be inserted, with its expiry time set
+ * @return 0 on success, -1 if the heap storage could not be grown
+ * @note O(log n). The caller must hold the environment mutex.
+ */
+int pal_os_timer_heap_insert(pal_timer_t *timer);
+
+/**
+ * @brief Remove a timer from the timer heap
+ * @param timer Pointer to the timer to be removed. Nothing is done if the timer is not in the heap.
+ * @note O(log n). The caller must hold the environment mutex.
+ */
+void pal_os_timer_heap_remove(pal_timer_t *timer);
+
+/**
+ * @brief Restore the heap order after the expiry time or the slack of a timer in the heap changed
+ * @param timer Pointer to the rescheduled timer
+ * @note O(log n). The caller must hold the environment mutex.
+ */
+void pal_os_timer_heap_update(pal_timer_t *timer);
+
+/**
+ * @brief Get the timer of a shard whose slack window ends first
+ * @param env Pointer to the shard
+ * @return Pointer to the timer, or NULL if the heap is empty
+ * @note O(1). The caller must hold the environment mutex.
+ */
+pal_timer_t *pal_os_timer_heap_top(pal_timer_env_t *env);
+
+/**
+ * @brief Move every timer of the heap of a shard due at or before now to its expired list
+ * @param env Pointer to the shard
+ * @param now Current time
+ * @return Number of timers moved to the expired list
+ * @note O(k log n) for k due timers. The caller must hold the environment mutex.
+ */
+size_t pal_os_timer_heap_expire(pal_timer_env_t *env, const struct timespec *now);
+
+/**
+ * @brief Insert a timer into the slot of the timing wheel matching its expiry time
+ * @param timer Pointer to the timer to be inserted, with its expiry time set
+ * @param now Current time, used to restart the wheel when it was empty
+ * @note O(1). The expiry time is rounded up to the next tick. The caller must hold the environment mutex.
+ */
+void pal_os_timer_wheel_insert(pal_timer_t *timer, const struct timespec *now);
+
+/**
+ * @brief Remove a timer from the timing wheel
+ * @param timer Pointer to the timer to be removed. Nothing is done if the timer is not on the wheel.
+ * @note O(1). The caller must hold the environment mutex.
+ */
+void pal_os_timer_wheel_remove(pal_timer_t *timer);
+
+/**
+ * @brief Process the wheel slots of a shard for every tick elapsed up to now, moving the due timers to its expired list
+ * @param env Pointer to the shard
+ * @param now Current time
+ * @return Number of timers moved to the expired list
+ * @note At most PAL_TIMER_WHEEL_SLOTS slots are visited, however long the thread slept. The caller must hold the environment mutex.
  */
-void pal_os_timer_insert_sorted(pal_timer_t *timer);
+size_t pal_os_timer_wheel_advance(pal_timer_env_t *env, const struct timespec *now);
 
 /**
- * @brief Remove a timer from the sorted timer list
- * @param timer Pointer to the timer to be inserted
+ * @brief Take the oldest timer from the expired list of a shard
+ * @param env Pointer to the shard
+ * @return Pointer to the timer, or NULL if no timer is due
+ * @note O(1). The caller must hold the environment mutex.
  */
-void pal_os_timer_remove(pal_timer_t *timer);
+pal_timer_t *pal_os_timer_expired_pop(pal_timer_env_t *env);
 
 /**
  * @brief Timer thread function
- * @param arg Pointer to user-defined argument passed to the thread function
+ * @param arg Pointer to the shard the thread serves
  * @note This function is intended to be used as the entry point for the timer thread.
  */
 void *pal_timer_thread_fn(void *arg);
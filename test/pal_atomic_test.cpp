@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/atomic.h"
+
+TEST(pal_os_atomic, u32OperationsReturnPreviousValue)
+{
+	uint32_t value = 0;
+	pal_atomic_u32_store(&value, 5, PAL_ATOMIC_RELAXED);
+	EXPECT_EQ(5, pal_atomic_u32_load(&value, PAL_ATOMIC_ACQUIRE));
+	EXPECT_EQ(5, pal_atomic_u32_exchange(&value, 6, PAL_ATOMIC_ACQ_REL));
+	EXPECT_EQ(6, pal_atomic_u32_fetch_add(&value, 2, PAL_ATOMIC_SEQ_CST));
+	EXPECT_EQ(8, pal_atomic_u32_fetch_sub(&value, 1, PAL_ATOMIC_RELEASE));
+	EXPECT_EQ(7, pal_atomic_u32_fetch_or(&value, 0x10, PAL_ATOMIC_RELAXED));
+	EXPECT_EQ(0x17, pal_atomic_u32_fetch_and(&value, 0x10, PAL_ATOMIC_RELAXED));
+	EXPECT_EQ(0x10, value);
+}
+
+TEST(pal_os_atomic, compareExchangeUpdatesExpected)
+{
+	uint32_t value	  = 1;
+	uint32_t expected = 2;
+	EXPECT_FALSE(pal_atomic_u32_compare_exchange(&value, &expected, 3, PAL_ATOMIC_RELEASE));
+	EXPECT_EQ(1, expected);
+	EXPECT_TRUE(pal_atomic_u32_compare_exchange(&value, &expected, 3, PAL_ATOMIC_ACQ_REL));
+	EXPECT_EQ(3, value);
+
+	size_t size			 = 10;
+	size_t size_expected = 10;
+	EXPECT_TRUE(pal_atomic_size_compare_exchange(&size, &size_expected, 20, PAL_ATOMIC_SEQ_CST));
+	EXPECT_EQ(20, pal_atomic_size_fetch_add(&size, 1, PAL_ATOMIC_RELAXED));
+	EXPECT_EQ(21, pal_atomic_size_fetch_sub(&size, 1, PAL_ATOMIC_RELAXED));
+	EXPECT_EQ(20, pal_atomic_size_fetch_or(&size, 0x5, PAL_ATOMIC_RELEASE));
+	EXPECT_EQ(21, pal_atomic_size_fetch_and(&size, ~(size_t)0x1, PAL_ATOMIC_ACQUIRE));
+	EXPECT_EQ(20, pal_atomic_size_load(&size, PAL_ATOMIC_RELAXED));
+
+	int	  a				= 0;
+	int	  b				= 0;
+	void *ptr			= &a;
+	void *ptr_expected	= &b;
+	EXPECT_FALSE(pal_atomic_ptr_compare_exchange(&ptr, &ptr_expected, &b, PAL_ATOMIC_ACQUIRE));
+	EXPECT_EQ(&a, ptr_expected);
+	EXPECT_TRUE(pal_atomic_ptr_compare_exchange(&ptr, &ptr_expected, &b, PAL_ATOMIC_ACQUIRE));
+	EXPECT_EQ(&b, pal_atomic_ptr_exchange(&ptr, &a, PAL_ATOMIC_ACQ_REL));
+	EXPECT_EQ(&a, pal_atomic_ptr_load(&ptr, PAL_ATOMIC_ACQUIRE));
+}
+
+TEST(pal_os_atomic, concurrentFetchAddIsAtomic)
+{
+	const int iterations = 100000;
+	uint32_t  counter	 = 0;
+	auto	  worker	 = [&]()
+	{
+		for (int i = 0; i < iterations; i++)
+		{
+			pal_atomic_u32_fetch_add(&counter, 1, PAL_ATOMIC_RELAXED);
+			pal_cpu_relax();
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	t1.join();
+	t2.join();
+	pal_atomic_fence(PAL_ATOMIC_SEQ_CST);
+	EXPECT_EQ(2 * iterations, counter);
+}
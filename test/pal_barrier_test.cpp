@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/barrier.h"
+
+TEST(pal_os_barrier, createBarrierFailure)
+{
+	pal_barrier_t barrier = {0};
+	EXPECT_EQ(-1, pal_barrier_create(nullptr, 2));
+	EXPECT_EQ(-1, pal_barrier_create(&barrier, 0));
+}
+
+TEST(pal_os_barrier, waitNullPtrFailure) { EXPECT_EQ(-1, pal_barrier_wait(nullptr)); }
+
+TEST(pal_os_barrier, singleThreadBarrierIsSerial)
+{
+	pal_barrier_t barrier = PAL_BARRIER_INITIALIZER(1);
+	EXPECT_EQ(PAL_BARRIER_SERIAL_THREAD, pal_barrier_wait(&barrier));
+	EXPECT_EQ(PAL_BARRIER_SERIAL_THREAD, pal_barrier_wait(&barrier));
+	EXPECT_EQ(0, pal_barrier_destroy(&barrier));
+}
+
+TEST(pal_os_barrier, cyclicRoundsSuccess)
+{
+	const int	  threads = 4;
+	const int	  rounds  = 100;
+	pal_barrier_t barrier = {0};
+	int			  serial  = 0;
+	int			  phase[threads];
+	int			  mismatches = 0;
+	EXPECT_EQ(0, pal_barrier_create(&barrier, threads));
+	auto worker = [&](int id)
+	{
+		for (int round = 0; round < rounds; round++)
+		{
+			__atomic_store_n(&phase[id], round, __ATOMIC_RELAXED);
+			int ret = pal_barrier_wait(&barrier);
+			if (PAL_BARRIER_SERIAL_THREAD == ret)
+			{
+				__atomic_fetch_add(&serial, 1, __ATOMIC_RELAXED);
+			}
+			// Nobody can be in a different round while everybody is between two barriers
+			for (int other = 0; other < threads; other++)
+			{
+				if (round != __atomic_load_n(&phase[other], __ATOMIC_RELAXED))
+				{
+					__atomic_fetch_add(&mismatches, 1, __ATOMIC_RELAXED);
+				}
+			}
+			pal_barrier_wait(&barrier);
+		}
+	};
+	std::thread t0(worker, 0);
+	std::thread t1(worker, 1);
+	std::thread t2(worker, 2);
+	std::thread t3(worker, 3);
+	t0.join();
+	t1.join();
+	t2.join();
+	t3.join();
+	EXPECT_EQ(rounds, serial);
+	EXPECT_EQ(0, mismatches);
+	EXPECT_EQ(0, pal_barrier_destroy(&barrier));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/combiner.h"
+
+typedef struct combiner_test_stats_s
+{
+	size_t count;
+	size_t sum;
+} combiner_test_stats_t;
+
+static void combiner_test_add(void *object, void *arg)
+{
+	combiner_test_stats_t *stats = (combiner_test_stats_t *)object;
+	size_t				  *value = (size_t *)arg;
+	stats->count++;
+	stats->sum += *value;
+	// Return the running count through the argument
+	*value = stats->count;
+}
+
+TEST(pal_os_combiner, createCombinerNullPtrFailure) { EXPECT_EQ(-1, pal_combiner_create(nullptr, nullptr)); }
+
+TEST(pal_os_combiner, executeNullPtrFailure)
+{
+	combiner_test_stats_t stats	   = {0, 0};
+	pal_combiner_t		  combiner = PAL_COMBINER_INITIALIZER(&stats);
+	pal_combiner_op_t	  op	   = {};
+	size_t				  value	   = 1;
+	EXPECT_EQ(-1, pal_combiner_execute(nullptr, &op, combiner_test_add, &value));
+	EXPECT_EQ(-1, pal_combiner_execute(&combiner, nullptr, combiner_test_add, &value));
+	EXPECT_EQ(-1, pal_combiner_execute(&combiner, &op, nullptr, &value));
+	EXPECT_EQ(0, stats.count);
+}
+
+TEST(pal_os_combiner, executeReturnsResult)
+{
+	combiner_test_stats_t stats	   = {0, 0};
+	pal_combiner_t		  combiner = {};
+	pal_combiner_op_t	  op	   = {};
+	size_t				  value	   = 5;
+	EXPECT_EQ(0, pal_combiner_create(&combiner, &stats));
+	EXPECT_EQ(0, pal_combiner_execute(&combiner, &op, combiner_test_add, &value));
+	EXPECT_EQ(1, value);
+	value = 7;
+	EXPECT_EQ(0, pal_combiner_execute(&combiner, &op, combiner_test_add, &value));
+	EXPECT_EQ(2, value);
+	EXPECT_EQ(12, stats.sum);
+	EXPECT_EQ(0, pal_combiner_destroy(&combiner));
+}
+
+TEST(pal_os_combiner, concurrentExecuteAppliesEveryOperation)
+{
+	const size_t		  iterations = 20000;
+	combiner_test_stats_t stats		 = {0, 0};
+	pal_combiner_t		  combiner	 = PAL_COMBINER_INITIALIZER(&stats);
+	auto				  worker	 = [&]()
+	{
+		pal_combiner_op_t op	= {};
+		size_t			  last	= 0;
+		for (size_t i = 0; i < iterations; i++)
+		{
+			size_t value = 1;
+			EXPECT_EQ(0, pal_combiner_execute(&combiner, &op, combiner_test_add, &value));
+			// The running count seen by one thread can only grow
+			EXPECT_GT(value, last);
+			last = value;
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	std::thread t3(worker);
+	std::thread t4(worker);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	EXPECT_EQ(4 * iterations, stats.count);
+	EXPECT_EQ(4 * iterations, stats.sum);
+	EXPECT_EQ(0, pal_combiner_destroy(&combiner));
+}
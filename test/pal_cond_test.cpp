@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/common.h"
+#include "pal_os/cond.h"
+#include "pal_os/mutex.h"
+
+TEST(pal_os_cond, createCondNullPtrFailure) { EXPECT_EQ(-1, pal_cond_create(nullptr)); }
+
+TEST(pal_os_cond, createDestroyCondSuccess)
+{
+	pal_cond_t cond = {0};
+	EXPECT_EQ(0, pal_cond_create(&cond));
+	EXPECT_EQ(0, pal_cond_destroy(&cond));
+}
+
+TEST(pal_os_cond, signalNullPtrFailure)
+{
+	EXPECT_EQ(-1, pal_cond_signal(nullptr));
+	EXPECT_EQ(-1, pal_cond_broadcast(nullptr));
+}
+
+TEST(pal_os_cond, waitNullPtrFailure)
+{
+	pal_cond_t	cond  = PAL_COND_INITIALIZER;
+	pal_mutex_t mutex = PAL_MUTEX_INITIALIZER;
+	EXPECT_EQ(-1, pal_cond_wait(nullptr, &mutex));
+	EXPECT_EQ(-1, pal_cond_wait(&cond, nullptr));
+}
+
+TEST(pal_os_cond, waitWithoutLockedMutexFailure)
+{
+	pal_cond_t	cond  = PAL_COND_INITIALIZER;
+	pal_mutex_t mutex = PAL_MUTEX_INITIALIZER;
+	EXPECT_EQ(-1, pal_cond_timedwait(&cond, &mutex, 100));
+	EXPECT_EQ(0, cond.waiters);
+}
+
+TEST(pal_os_cond, waitWithNestedRecursiveMutexFailure)
+{
+	pal_cond_t	cond	   = PAL_COND_INITIALIZER;
+	pal_mutex_t mutex	   = {};
+	time_t		start_time = 0;
+	time_t		stop_time  = 0;
+	EXPECT_EQ(0, pal_mutex_create(&mutex, 1));
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+	// The wait could only drop one of the two levels, it fails at once instead of sleeping with the mutex held
+	start_time = time(NULL);
+	EXPECT_EQ(-1, pal_cond_timedwait(&cond, &mutex, 5000));
+	stop_time = time(NULL);
+	EXPECT_GT(2, stop_time - start_time);
+	EXPECT_EQ(0, cond.waiters);
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(-1, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(0, pal_mutex_destroy(&mutex));
+}
+
+TEST(pal_os_cond, timedWaitTimeout)
+{
+	pal_cond_t	cond	   = PAL_COND_INITIALIZER;
+	pal_mutex_t mutex	   = PAL_MUTEX_INITIALIZER;
+	time_t		start_time = 0;
+	time_t		stop_time  = 0;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+	start_time = time(NULL);
+	EXPECT_EQ(-1, pal_cond_timedwait(&cond, &mutex, 1000));
+	stop_time = time(NULL);
+	EXPECT_EQ(1, stop_time - start_time);
+	// The mutex is held again after the timeout
+	EXPECT_EQ(-1, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+}
+
+TEST(pal_os_cond, signalWakesPredicateWaiter)
+{
+	static pal_cond_t  cond	 = PAL_COND_INITIALIZER;
+	static pal_mutex_t mutex = PAL_MUTEX_INITIALIZER;
+	int				   ready = 0;
+
+	std::thread producer(
+		[&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT);
+			ready = 1;
+			pal_cond_signal(&cond);
+			pal_mutex_unlock(&mutex);
+		});
+
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+	while (!ready)
+	{
+		EXPECT_EQ(0, pal_cond_timedwait(&cond, &mutex, 1000));
+	}
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	producer.join();
+}
+
+TEST(pal_os_cond, broadcastWakesAllWaiters)
+{
+	pal_cond_t	cond	= PAL_COND_INITIALIZER;
+	pal_mutex_t mutex	= PAL_MUTEX_INITIALIZER;
+	int			go		= 0;
+	int			started = 0;
+	int			woken	= 0;
+	auto		waiter	= [&]()
+	{
+		pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT);
+		started++;
+		while (!go)
+		{
+			pal_cond_wait(&cond, &mutex);
+		}
+		woken++;
+		pal_mutex_unlock(&mutex);
+	};
+	std::thread t1(waiter);
+	std::thread t2(waiter);
+	std::thread t3(waiter);
+	while (3 != __atomic_load_n(&started, __ATOMIC_SEQ_CST))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT);
+	go = 1;
+	EXPECT_EQ(0, pal_cond_broadcast(&cond));
+	pal_mutex_unlock(&mutex);
+	t1.join();
+	t2.join();
+	t3.join();
+	EXPECT_EQ(3, woken);
+	EXPECT_EQ(0, pal_cond_destroy(&cond));
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+
+#include <thread>
+#include <vector>
+
+#include "pal_os/epoch.h"
+
+typedef struct epoch_test_object_s
+{
+	pal_epoch_node_t node;
+	int				 value;
+	int				*released;
+} epoch_test_object_t;
+
+static void epoch_test_release(pal_epoch_node_t *node)
+{
+	epoch_test_object_t *object = (epoch_test_object_t *)((char *)node - offsetof(epoch_test_object_t, node));
+	(*object->released)++;
+	object->value = -1;
+	delete object;
+}
+
+TEST(pal_os_epoch, nullPtrFailure)
+{
+	pal_epoch_t		   epoch  = PAL_EPOCH_INITIALIZER;
+	pal_epoch_record_t record = {};
+	EXPECT_EQ(-1, pal_epoch_create(nullptr));
+	EXPECT_EQ(-1, pal_epoch_register(nullptr, &record));
+	EXPECT_EQ(-1, pal_epoch_register(&epoch, nullptr));
+	EXPECT_EQ(-1, pal_epoch_enter(nullptr));
+	EXPECT_EQ(-1, pal_epoch_exit(&record));
+	EXPECT_EQ(0, pal_epoch_reclaim(nullptr));
+}
+
+TEST(pal_os_epoch, nestedSectionsAndUnregisterInsideSectionFailure)
+{
+	pal_epoch_t		   epoch  = {};
+	pal_epoch_record_t record = {};
+	EXPECT_EQ(0, pal_epoch_create(&epoch));
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &record));
+	EXPECT_EQ(-1, pal_epoch_destroy(&epoch));
+	EXPECT_EQ(0, pal_epoch_enter(&record));
+	EXPECT_EQ(0, pal_epoch_enter(&record));
+	EXPECT_EQ(0, pal_epoch_exit(&record));
+	EXPECT_EQ(-1, pal_epoch_unregister(&record));
+	EXPECT_EQ(0, pal_epoch_exit(&record));
+	EXPECT_EQ(-1, pal_epoch_exit(&record));
+	EXPECT_EQ(0, pal_epoch_unregister(&record));
+	EXPECT_EQ(0, pal_epoch_destroy(&epoch));
+}
+
+TEST(pal_os_epoch, retiredObjectReleasedAfterGracePeriod)
+{
+	pal_epoch_t			 epoch	  = PAL_EPOCH_INITIALIZER;
+	pal_epoch_record_t	 record	  = {};
+	int					 released = 0;
+	epoch_test_object_t *object	  = new epoch_test_object_t{{}, 1, &released};
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &record));
+	EXPECT_EQ(0, pal_epoch_retire(&record, &object->node, epoch_test_release));
+	// Two epoch advances are needed before the object can be released
+	EXPECT_EQ(0, pal_epoch_reclaim(&record));
+	EXPECT_EQ(1, pal_epoch_reclaim(&record));
+	EXPECT_EQ(1, released);
+	EXPECT_EQ(0, pal_epoch_unregister(&record));
+}
+
+TEST(pal_os_epoch, activeReaderDelaysRelease)
+{
+	pal_epoch_t			 epoch	  = PAL_EPOCH_INITIALIZER;
+	pal_epoch_record_t	 writer	  = {};
+	pal_epoch_record_t	 reader	  = {};
+	int					 released = 0;
+	epoch_test_object_t *object	  = new epoch_test_object_t{{}, 1, &released};
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &writer));
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &reader));
+	EXPECT_EQ(0, pal_epoch_enter(&reader));
+	EXPECT_EQ(0, pal_epoch_retire(&writer, &object->node, epoch_test_release));
+	for (int i = 0; i < 10; i++)
+	{
+		EXPECT_EQ(0, pal_epoch_reclaim(&writer));
+	}
+	EXPECT_EQ(1, object->value);
+	EXPECT_EQ(0, pal_epoch_exit(&reader));
+	pal_epoch_reclaim(&writer);
+	pal_epoch_reclaim(&writer);
+	EXPECT_EQ(1, released);
+	EXPECT_EQ(0, pal_epoch_unregister(&reader));
+	EXPECT_EQ(0, pal_epoch_unregister(&writer));
+}
+
+TEST(pal_os_epoch, unregisterHandsRetiredObjectsToDomain)
+{
+	pal_epoch_t			 epoch	  = PAL_EPOCH_INITIALIZER;
+	pal_epoch_record_t	 writer	  = {};
+	pal_epoch_record_t	 reader	  = {};
+	int					 released = 0;
+	epoch_test_object_t *object	  = new epoch_test_object_t{{}, 1, &released};
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &writer));
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &reader));
+	EXPECT_EQ(0, pal_epoch_enter(&reader));
+	EXPECT_EQ(0, pal_epoch_retire(&writer, &object->node, epoch_test_release));
+	// The reader holds the object, the writer leaves it to the domain instead of waiting
+	EXPECT_EQ(0, pal_epoch_unregister(&writer));
+	EXPECT_EQ(nullptr, writer.retired);
+	EXPECT_EQ(0, released);
+	EXPECT_EQ(0, pal_epoch_exit(&reader));
+	pal_epoch_reclaim(&reader);
+	pal_epoch_reclaim(&reader);
+	EXPECT_EQ(1, released);
+	EXPECT_EQ(0, pal_epoch_unregister(&reader));
+}
+
+TEST(pal_os_epoch, destroyReleasesRetiredObjectsOfUnregisteredThreads)
+{
+	pal_epoch_t			 epoch	  = {};
+	pal_epoch_record_t	 record	  = {};
+	int					 released = 0;
+	epoch_test_object_t *object	  = new epoch_test_object_t{{}, 1, &released};
+	EXPECT_EQ(0, pal_epoch_create(&epoch));
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &record));
+	EXPECT_EQ(0, pal_epoch_retire(&record, &object->node, epoch_test_release));
+	EXPECT_EQ(0, pal_epoch_unregister(&record));
+	EXPECT_EQ(0, released);
+	EXPECT_EQ(0, pal_epoch_destroy(&epoch));
+	EXPECT_EQ(1, released);
+}
+
+static void epoch_test_poison(pal_epoch_node_t *node)
+{
+	epoch_test_object_t *object = (epoch_test_object_t *)((char *)node - offsetof(epoch_test_object_t, node));
+	(*object->released)++;
+	// The pool keeps the memory, a reader still holding the object sees the poison instead of freed memory
+	__atomic_store_n(&object->value, -1, __ATOMIC_RELAXED);
+}
+
+TEST(pal_os_epoch, concurrentSectionsKeepEveryReadObject)
+{
+	pal_epoch_t						 epoch	  = PAL_EPOCH_INITIALIZER;
+	int								 released = 0;
+	int								 stop	  = 0;
+	int								 invalid  = 0;
+	std::vector<epoch_test_object_t> pool(10001, epoch_test_object_t{{}, 0, &released});
+	epoch_test_object_t				*shared = &pool[0];
+	auto							 reader = [&]()
+	{
+		pal_epoch_record_t record = {};
+		pal_epoch_register(&epoch, &record);
+		while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+		{
+			// Unlike a hazard slot, a section keeps every object read inside it alive until it exits, not only the last one
+			epoch_test_object_t *objects[4];
+			pal_epoch_enter(&record);
+			for (epoch_test_object_t *&object : objects)
+			{
+				object = __atomic_load_n(&shared, __ATOMIC_ACQUIRE);
+				std::this_thread::yield();
+			}
+			for (epoch_test_object_t *object : objects)
+			{
+				if (__atomic_load_n(&object->value, __ATOMIC_RELAXED) < 0)
+				{
+					__atomic_fetch_add(&invalid, 1, __ATOMIC_RELAXED);
+				}
+			}
+			pal_epoch_exit(&record);
+		}
+		pal_epoch_unregister(&record);
+	};
+	std::thread		   t1(reader);
+	std::thread		   t2(reader);
+	pal_epoch_record_t record = {};
+	EXPECT_EQ(0, pal_epoch_register(&epoch, &record));
+	for (int i = 1; i <= 10000; i++)
+	{
+		pool[i].value			 = i;
+		epoch_test_object_t *old = __atomic_exchange_n(&shared, &pool[i], __ATOMIC_ACQ_REL);
+		EXPECT_EQ(0, pal_epoch_retire(&record, &old->node, epoch_test_poison));
+	}
+	__atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+	t1.join();
+	t2.join();
+	EXPECT_EQ(0, pal_epoch_unregister(&record));
+	EXPECT_EQ(0, pal_epoch_destroy(&epoch));
+	EXPECT_EQ(10000, released);
+	EXPECT_EQ(0, invalid);
+}
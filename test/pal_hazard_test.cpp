@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "pal_os/hazard.h"
+
+typedef struct hazard_test_object_s
+{
+	pal_hazard_node_t node;
+	int				  value;
+	int				 *released;
+} hazard_test_object_t;
+
+static void hazard_test_release(pal_hazard_node_t *node)
+{
+	hazard_test_object_t *object = (hazard_test_object_t *)((char *)node - offsetof(hazard_test_object_t, node));
+	(*object->released)++;
+	object->value = -1;
+	delete object;
+}
+
+TEST(pal_os_hazard, nullPtrFailure)
+{
+	pal_hazard_t		hazard = PAL_HAZARD_INITIALIZER;
+	pal_hazard_record_t record = {};
+	void			   *src	   = &record;
+	EXPECT_EQ(-1, pal_hazard_create(nullptr));
+	EXPECT_EQ(-1, pal_hazard_register(nullptr, &record));
+	EXPECT_EQ(-1, pal_hazard_register(&hazard, nullptr));
+	EXPECT_EQ(-1, pal_hazard_unregister(&record));
+	EXPECT_EQ(nullptr, pal_hazard_protect(nullptr, 0, &src));
+	EXPECT_EQ(nullptr, pal_hazard_protect(&record, PAL_HAZARD_SLOTS, &src));
+	EXPECT_EQ(-1, pal_hazard_clear(&record, PAL_HAZARD_SLOTS));
+	EXPECT_EQ(-1, pal_hazard_retire(&record, nullptr, nullptr, hazard_test_release));
+	EXPECT_EQ(0, pal_hazard_scan(nullptr));
+	EXPECT_EQ(-1, pal_hazard_destroy(nullptr));
+}
+
+TEST(pal_os_hazard, destroyWithRegisteredThreadFailure)
+{
+	pal_hazard_t		hazard = {};
+	pal_hazard_record_t record = {};
+	EXPECT_EQ(0, pal_hazard_create(&hazard));
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &record));
+	EXPECT_EQ(-1, pal_hazard_destroy(&hazard));
+	EXPECT_EQ(0, pal_hazard_unregister(&record));
+	EXPECT_EQ(0, pal_hazard_destroy(&hazard));
+}
+
+TEST(pal_os_hazard, protectedObjectNotReleased)
+{
+	pal_hazard_t		  hazard   = PAL_HAZARD_INITIALIZER;
+	pal_hazard_record_t	  writer   = {};
+	pal_hazard_record_t	  reader   = {};
+	int					  released = 0;
+	hazard_test_object_t *object   = new hazard_test_object_t{{}, 1, &released};
+	hazard_test_object_t *shared   = object;
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &writer));
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &reader));
+	EXPECT_EQ(object, pal_hazard_protect(&reader, 1, (void *const *)&shared));
+	shared = nullptr;
+	EXPECT_EQ(0, pal_hazard_retire(&writer, &object->node, object, hazard_test_release));
+	EXPECT_EQ(0, pal_hazard_scan(&writer));
+	EXPECT_EQ(1, object->value);
+	EXPECT_EQ(0, pal_hazard_clear(&reader, 1));
+	EXPECT_EQ(1, pal_hazard_scan(&writer));
+	EXPECT_EQ(1, released);
+	EXPECT_EQ(0, pal_hazard_unregister(&reader));
+	EXPECT_EQ(0, pal_hazard_unregister(&writer));
+}
+
+TEST(pal_os_hazard, retireScansAtThreshold)
+{
+	pal_hazard_t		hazard	 = PAL_HAZARD_INITIALIZER;
+	pal_hazard_record_t record	 = {};
+	int					released = 0;
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &record));
+	for (int i = 0; i < PAL_HAZARD_SCAN_THRESHOLD - 1; i++)
+	{
+		hazard_test_object_t *object = new hazard_test_object_t{{}, i, &released};
+		EXPECT_EQ(0, pal_hazard_retire(&record, &object->node, object, hazard_test_release));
+	}
+	EXPECT_EQ(0, released);
+	hazard_test_object_t *object = new hazard_test_object_t{{}, 0, &released};
+	EXPECT_EQ(0, pal_hazard_retire(&record, &object->node, object, hazard_test_release));
+	EXPECT_EQ(PAL_HAZARD_SCAN_THRESHOLD, released);
+	EXPECT_EQ(0, pal_hazard_unregister(&record));
+}
+
+static const int hazardTestReaders = (PAL_HAZARD_SCAN_THRESHOLD + PAL_HAZARD_SLOTS - 1) / PAL_HAZARD_SLOTS;
+
+TEST(pal_os_hazard, retireThresholdSkipsProtectedObjects)
+{
+	pal_hazard_t		  hazard					 = PAL_HAZARD_INITIALIZER;
+	pal_hazard_record_t	  writer					 = {};
+	pal_hazard_record_t	  readers[hazardTestReaders] = {};
+	int					  released					 = 0;
+	hazard_test_object_t *object					 = nullptr;
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &writer));
+	for (int i = 0; i < PAL_HAZARD_SCAN_THRESHOLD; i++)
+	{
+		if (0 == i % PAL_HAZARD_SLOTS)
+		{
+			EXPECT_EQ(0, pal_hazard_register(&hazard, &readers[i / PAL_HAZARD_SLOTS]));
+		}
+		object = new hazard_test_object_t{{}, i, &released};
+		EXPECT_EQ(object, pal_hazard_protect(&readers[i / PAL_HAZARD_SLOTS], i % PAL_HAZARD_SLOTS, (void *const *)&object));
+		EXPECT_EQ(0, pal_hazard_retire(&writer, &object->node, object, hazard_test_release));
+	}
+	EXPECT_EQ(0, released);
+	// The protected objects stay retired, the next scan waits for PAL_HAZARD_SCAN_THRESHOLD new ones
+	for (int i = 0; i < PAL_HAZARD_SCAN_THRESHOLD - 1; i++)
+	{
+		object = new hazard_test_object_t{{}, i, &released};
+		EXPECT_EQ(0, pal_hazard_retire(&writer, &object->node, object, hazard_test_release));
+	}
+	EXPECT_EQ(0, released);
+	object = new hazard_test_object_t{{}, 0, &released};
+	EXPECT_EQ(0, pal_hazard_retire(&writer, &object->node, object, hazard_test_release));
+	EXPECT_EQ(PAL_HAZARD_SCAN_THRESHOLD, released);
+	for (pal_hazard_record_t &reader : readers)
+	{
+		EXPECT_EQ(0, pal_hazard_unregister(&reader));
+	}
+	EXPECT_EQ(0, pal_hazard_unregister(&writer));
+	EXPECT_EQ(2 * PAL_HAZARD_SCAN_THRESHOLD, released);
+}
+
+typedef struct hazard_test_parent_s
+{
+	pal_hazard_node_t	  node;
+	pal_hazard_record_t	 *record;
+	hazard_test_object_t *child;
+} hazard_test_parent_t;
+
+static void hazard_test_release_parent(pal_hazard_node_t *node)
+{
+	hazard_test_parent_t *parent = (hazard_test_parent_t *)((char *)node - offsetof(hazard_test_parent_t, node));
+	// Releasing an object can retire the objects it owns and scan for them
+	EXPECT_EQ(0, pal_hazard_retire(parent->record, &parent->child->node, parent->child, hazard_test_release));
+	EXPECT_EQ(1, pal_hazard_scan(parent->record));
+	delete parent;
+}
+
+TEST(pal_os_hazard, releaseRetiresChild)
+{
+	pal_hazard_t		  hazard   = PAL_HAZARD_INITIALIZER;
+	pal_hazard_record_t	  record   = {};
+	int					  released = 0;
+	hazard_test_parent_t *parent   = new hazard_test_parent_t{{}, &record, new hazard_test_object_t{{}, 1, &released}};
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &record));
+	EXPECT_EQ(0, pal_hazard_retire(&record, &parent->node, parent, hazard_test_release_parent));
+	EXPECT_EQ(1, pal_hazard_scan(&record));
+	EXPECT_EQ(1, released);
+	EXPECT_EQ(0, pal_hazard_unregister(&record));
+}
+
+static void hazard_test_poison(pal_hazard_node_t *node)
+{
+	hazard_test_object_t *object = (hazard_test_object_t *)((char *)node - offsetof(hazard_test_object_t, node));
+	(*object->released)++;
+	// The pool keeps the memory, a reader still holding the object sees the poison instead of freed memory
+	__atomic_store_n(&object->value, -1, __ATOMIC_RELAXED);
+}
+
+TEST(pal_os_hazard, concurrentRetireBoundsUnreleasedObjects)
+{
+	pal_hazard_t					  hazard	 = PAL_HAZARD_INITIALIZER;
+	int								  released	 = 0;
+	int								  stop		 = 0;
+	int								  invalid	 = 0;
+	size_t							  unreleased = 0;
+	std::vector<hazard_test_object_t> pool(10001, hazard_test_object_t{{}, 0, &released});
+	hazard_test_object_t			 *shared = &pool[0];
+	auto							  reader = [&]()
+	{
+		pal_hazard_record_t record = {};
+		pal_hazard_register(&hazard, &record);
+		while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+		{
+			hazard_test_object_t *object = (hazard_test_object_t *)pal_hazard_protect(&record, 0, (void *const *)&shared);
+			// The writer keeps retiring while the reader holds the object
+			std::this_thread::yield();
+			if (__atomic_load_n(&object->value, __ATOMIC_RELAXED) < 0)
+			{
+				__atomic_fetch_add(&invalid, 1, __ATOMIC_RELAXED);
+			}
+			pal_hazard_clear(&record, 0);
+		}
+		pal_hazard_unregister(&record);
+	};
+	std::thread			t1(reader);
+	std::thread			t2(reader);
+	pal_hazard_record_t record = {};
+	EXPECT_EQ(0, pal_hazard_register(&hazard, &record));
+	for (int i = 1; i <= 10000; i++)
+	{
+		pool[i].value			  = i;
+		hazard_test_object_t *old = __atomic_exchange_n(&shared, &pool[i], __ATOMIC_ACQ_REL);
+		EXPECT_EQ(0, pal_hazard_retire(&record, &old->node, old, hazard_test_poison));
+		unreleased = std::max(unreleased, (size_t)(i - released));
+	}
+	__atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+	t1.join();
+	t2.join();
+	// However fast the writer retires, only the objects in the two reader slots outlive a threshold scan
+	EXPECT_GE((size_t)PAL_HAZARD_SCAN_THRESHOLD + 2, unreleased);
+	EXPECT_EQ(0, pal_hazard_unregister(&record));
+	EXPECT_EQ(10000, released);
+	EXPECT_EQ(0, invalid);
+	EXPECT_EQ(0, pal_hazard_destroy(&hazard));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/common.h"
+#include "pal_os/latch.h"
+
+TEST(pal_os_latch, createLatchNullPtrFailure) { EXPECT_EQ(-1, pal_latch_create(nullptr, 1)); }
+
+TEST(pal_os_latch, zeroCountLatchIsOpen)
+{
+	pal_latch_t latch = {0};
+	EXPECT_EQ(0, pal_latch_create(&latch, 0));
+	EXPECT_EQ(0, pal_latch_wait(&latch, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(-1, pal_latch_count_down(&latch));
+	EXPECT_EQ(0, pal_latch_destroy(&latch));
+}
+
+TEST(pal_os_latch, waitTimeout)
+{
+	pal_latch_t latch	   = PAL_LATCH_INITIALIZER(1);
+	time_t		start_time = 0;
+	time_t		stop_time  = 0;
+	EXPECT_EQ(-1, pal_latch_wait(&latch, PAL_OS_NO_TIMEOUT));
+	start_time = time(NULL);
+	EXPECT_EQ(-1, pal_latch_wait(&latch, 1000));
+	stop_time = time(NULL);
+	EXPECT_EQ(1, stop_time - start_time);
+}
+
+TEST(pal_os_latch, countDownReleasesWaiters)
+{
+	pal_latch_t latch	= PAL_LATCH_INITIALIZER(3);
+	int			woken	= 0;
+	auto		waiter	= [&]()
+	{
+		if (0 == pal_latch_wait(&latch, PAL_OS_INFINITE_TIMEOUT))
+		{
+			__atomic_fetch_add(&woken, 1, __ATOMIC_RELAXED);
+		}
+	};
+	std::thread t1(waiter);
+	std::thread t2(waiter);
+	EXPECT_EQ(0, pal_latch_count_down(&latch));
+	EXPECT_EQ(0, pal_latch_count_down(&latch));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(0, __atomic_load_n(&woken, __ATOMIC_RELAXED));
+	EXPECT_EQ(0, pal_latch_count_down(&latch));
+	t1.join();
+	t2.join();
+	EXPECT_EQ(2, woken);
+	EXPECT_EQ(-1, pal_latch_count_down(&latch));
+	EXPECT_EQ(0, pal_latch_wait(&latch, PAL_OS_NO_TIMEOUT));
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/common.h"
+#include "pal_os/lock_stripe.h"
+
+TEST(pal_os_lock_stripe, createLockStripeFailure)
+{
+	pal_lock_stripe_t	   stripe	= {0};
+	pal_lock_stripe_slot_t slots[4] = {};
+	EXPECT_EQ(-1, pal_lock_stripe_create(nullptr, slots, 4));
+	EXPECT_EQ(-1, pal_lock_stripe_create(&stripe, nullptr, 4));
+	EXPECT_EQ(-1, pal_lock_stripe_create(&stripe, slots, 0));
+	EXPECT_EQ(-1, pal_lock_stripe_lock_key(&stripe, 1, PAL_OS_NO_TIMEOUT));
+}
+
+TEST(pal_os_lock_stripe, slotsArePadded)
+{
+	pal_lock_stripe_slot_t slots[2] = {};
+	EXPECT_EQ(0, sizeof(pal_lock_stripe_slot_t) % PAL_OS_CACHE_LINE_SIZE);
+	EXPECT_EQ(0, (uintptr_t)&slots[1] % PAL_OS_CACHE_LINE_SIZE);
+}
+
+TEST(pal_os_lock_stripe, keysSpreadOverSlots)
+{
+	pal_lock_stripe_t	   stripe	 = {0};
+	pal_lock_stripe_slot_t slots[8]	 = {};
+	int					   used[8]	 = {0};
+	int					   used_cnt	 = 0;
+	EXPECT_EQ(0, pal_lock_stripe_create(&stripe, slots, 8));
+	for (size_t key = 0; key < 64; key++)
+	{
+		size_t index = pal_lock_stripe_index(&stripe, key * 64);
+		ASSERT_LT(index, 8u);
+		EXPECT_EQ(index, pal_lock_stripe_index(&stripe, key * 64));
+		used[index]++;
+	}
+	for (int i = 0; i < 8; i++)
+	{
+		used_cnt += used[i] ? 1 : 0;
+	}
+	// Aligned keys must not collapse on a few slots
+	EXPECT_EQ(8, used_cnt);
+	EXPECT_EQ(0, pal_lock_stripe_destroy(&stripe));
+}
+
+TEST(pal_os_lock_stripe, lockKeyExcludesSameSlot)
+{
+	pal_lock_stripe_t	   stripe	= {0};
+	pal_lock_stripe_slot_t slots[4] = {};
+	EXPECT_EQ(0, pal_lock_stripe_create(&stripe, slots, 4));
+	EXPECT_EQ(0, pal_lock_stripe_lock_key(&stripe, 42, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(-1, pal_lock_stripe_lock_key(&stripe, 42, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_lock_stripe_unlock_key(&stripe, 42));
+	EXPECT_EQ(0, pal_lock_stripe_destroy(&stripe));
+}
+
+TEST(pal_os_lock_stripe, lockAllExcludesEveryKey)
+{
+	pal_lock_stripe_t	   stripe	= {0};
+	pal_lock_stripe_slot_t slots[4] = {};
+	EXPECT_EQ(0, pal_lock_stripe_create(&stripe, slots, 4));
+	EXPECT_EQ(0, pal_lock_stripe_lock_all(&stripe));
+	std::thread other(
+		[&]()
+		{
+			for (size_t key = 0; key < 16; key++)
+			{
+				EXPECT_EQ(-1, pal_lock_stripe_lock_key(&stripe, key, PAL_OS_NO_TIMEOUT));
+			}
+		});
+	other.join();
+	EXPECT_EQ(0, pal_lock_stripe_unlock_all(&stripe));
+	EXPECT_EQ(0, pal_lock_stripe_lock_key(&stripe, 3, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_lock_stripe_unlock_key(&stripe, 3));
+	EXPECT_EQ(0, pal_lock_stripe_destroy(&stripe));
+}
+
+TEST(pal_os_lock_stripe, concurrentKeyUpdatesSuccess)
+{
+	pal_lock_stripe_t	   stripe	   = {0};
+	pal_lock_stripe_slot_t slots[4]	   = {};
+	int					   counters[4] = {0};
+	EXPECT_EQ(0, pal_lock_stripe_create(&stripe, slots, 4));
+	auto worker = [&]()
+	{
+		for (size_t i = 0; i < 10000; i++)
+		{
+			size_t key = i % 4;
+			EXPECT_EQ(0, pal_lock_stripe_lock_key(&stripe, key, PAL_OS_INFINITE_TIMEOUT));
+			counters[key]++;
+			EXPECT_EQ(0, pal_lock_stripe_unlock_key(&stripe, key));
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	std::thread t3(worker);
+	t1.join();
+	t2.join();
+	t3.join();
+	EXPECT_EQ(30000, counters[0] + counters[1] + counters[2] + counters[3]);
+	EXPECT_EQ(0, pal_lock_stripe_destroy(&stripe));
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include "pal_os/common.h"
 #include "pal_os/mutex.h"
 
@@ -56,4 +58,108 @@ TEST(pal_os_mutex, lockWithTimeoutFail)
 	EXPECT_EQ(1, stop_time - start_time);
 	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
 	EXPECT_EQ(0, pal_mutex_destroy(&mutex));
-}
\ No newline at end of file
+}
+TEST(pal_os_mutex, staticInitializerNoCreate)
+{
+	static pal_mutex_t mutex = PAL_MUTEX_INITIALIZER;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(-1, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(0, pal_mutex_destroy(&mutex));
+}
+
+TEST(pal_os_mutex, staticRecursiveInitializerNoCreate)
+{
+	static pal_mutex_t mutex = PAL_RECURSIVE_MUTEX_INITIALIZER;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(-1, pal_mutex_unlock(&mutex));
+}
+
+TEST(pal_os_mutex, recursiveUnlockFromOtherThreadFailure)
+{
+	pal_mutex_t mutex = PAL_RECURSIVE_MUTEX_INITIALIZER;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	std::thread other([&]() { EXPECT_EQ(-1, pal_mutex_unlock(&mutex)); });
+	other.join();
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+}
+
+TEST(pal_os_mutex, contendedLockSuccess)
+{
+	static pal_mutex_t mutex   = PAL_MUTEX_INITIALIZER;
+	int				   counter = 0;
+	auto			   worker  = [&]()
+	{
+		for (int i = 0; i < 10000; i++)
+		{
+			EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+			counter++;
+			EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	std::thread t3(worker);
+	t1.join();
+	t2.join();
+	t3.join();
+	EXPECT_EQ(30000, counter);
+}
+
+TEST(pal_os_mutex, lockWithTimeoutFromOtherThreadSuccess)
+{
+	pal_mutex_t mutex = PAL_MUTEX_INITIALIZER;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	std::thread owner(
+		[&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			pal_mutex_unlock(&mutex);
+		});
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, 1000));
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	owner.join();
+}
+
+TEST(pal_os_mutex, recursiveContendedLockSuccess)
+{
+	pal_mutex_t mutex	= PAL_RECURSIVE_MUTEX_INITIALIZER;
+	int			counter = 0;
+	auto		worker	= [&]()
+	{
+		for (int i = 0; i < 10000; i++)
+		{
+			EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_INFINITE_TIMEOUT));
+			EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+			counter++;
+			EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+			EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	std::thread t3(worker);
+	t1.join();
+	t2.join();
+	t3.join();
+	EXPECT_EQ(30000, counter);
+	EXPECT_EQ(0, mutex.state);
+}
+
+TEST(pal_os_mutex, recursiveLockTimeoutWhileOwnedByOtherThread)
+{
+	pal_mutex_t mutex = PAL_RECURSIVE_MUTEX_INITIALIZER;
+	EXPECT_EQ(0, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+	std::thread other(
+		[&]()
+		{
+			EXPECT_EQ(-1, pal_mutex_lock(&mutex, PAL_OS_NO_TIMEOUT));
+			EXPECT_EQ(-1, pal_mutex_lock(&mutex, 50));
+		});
+	other.join();
+	EXPECT_EQ(0, pal_mutex_unlock(&mutex));
+	EXPECT_EQ(-1, pal_mutex_unlock(&mutex));
+}
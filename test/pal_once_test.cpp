@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/once.h"
+
+static void once_increment(void *arg)
+{
+	int *counter = (int *)arg;
+	// Give the other callers time to pile up on the running initialization
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	(*counter)++;
+}
+
+TEST(pal_os_once, callNullPtrFailure)
+{
+	pal_once_t once	   = PAL_ONCE_INIT;
+	int		   counter = 0;
+	EXPECT_EQ(-1, pal_once_call(nullptr, once_increment, &counter));
+	EXPECT_EQ(-1, pal_once_call(&once, nullptr, &counter));
+	EXPECT_EQ(0, counter);
+}
+
+TEST(pal_os_once, callRunsOnce)
+{
+	pal_once_t once	   = PAL_ONCE_INIT;
+	int		   counter = 0;
+	EXPECT_EQ(0, pal_once_call(&once, once_increment, &counter));
+	EXPECT_EQ(0, pal_once_call(&once, once_increment, &counter));
+	EXPECT_EQ(1, counter);
+}
+
+TEST(pal_os_once, concurrentCallersWaitForCompletion)
+{
+	pal_once_t once		= PAL_ONCE_INIT;
+	int		   counter	= 0;
+	int		   observed = 0;
+	auto	   caller	= [&]()
+	{
+		pal_once_call(&once, once_increment, &counter);
+		// Every caller must see the initialization completed
+		__atomic_fetch_add(&observed, counter, __ATOMIC_RELAXED);
+	};
+	std::thread t1(caller);
+	std::thread t2(caller);
+	std::thread t3(caller);
+	std::thread t4(caller);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	EXPECT_EQ(1, counter);
+	EXPECT_EQ(4, observed);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "pal_os/common.h"
+#include "pal_os/sem.h"
+
+TEST(pal_os_sem, createSemNullPtrFailure) { EXPECT_EQ(-1, pal_sem_create(nullptr, 1, 0)); }
+
+TEST(pal_os_sem, createSemInvalidCountFailure)
+{
+	pal_sem_t sem = {0};
+	EXPECT_EQ(-1, pal_sem_create(&sem, 0, 0));
+	EXPECT_EQ(-1, pal_sem_create(&sem, 2, 3));
+}
+
+TEST(pal_os_sem, createSemSuccess)
+{
+	pal_sem_t sem = {0};
+	EXPECT_EQ(0, pal_sem_create(&sem, 4, 2));
+	EXPECT_EQ(2, pal_sem_get_count(&sem));
+	EXPECT_EQ(0, pal_sem_destroy(&sem));
+}
+
+TEST(pal_os_sem, takeGiveNoTimeout)
+{
+	pal_sem_t sem = PAL_SEM_INITIALIZER(2, 2);
+	EXPECT_EQ(0, pal_sem_take(&sem, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_sem_take(&sem, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(-1, pal_sem_take(&sem, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, pal_sem_get_count(&sem));
+	EXPECT_EQ(0, pal_sem_give(&sem));
+	EXPECT_EQ(0, pal_sem_give_from_isr(&sem));
+	EXPECT_EQ(-1, pal_sem_give(&sem));
+	EXPECT_EQ(2, pal_sem_get_count(&sem));
+}
+
+TEST(pal_os_sem, nullPtrFailure)
+{
+	EXPECT_EQ(-1, pal_sem_take(nullptr, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(-1, pal_sem_give(nullptr));
+	EXPECT_EQ(0, pal_sem_get_count(nullptr));
+	EXPECT_EQ(-1, pal_sem_destroy(nullptr));
+}
+
+TEST(pal_os_sem, takeWithTimeoutFail)
+{
+	pal_sem_t sem		 = PAL_SEM_INITIALIZER(1, 0);
+	time_t	  start_time = time(NULL);
+	EXPECT_EQ(-1, pal_sem_take(&sem, 1000));
+	time_t stop_time = time(NULL);
+	EXPECT_EQ(1, stop_time - start_time);
+	EXPECT_EQ(0, sem.waiters);
+}
+
+TEST(pal_os_sem, takeBlocksUntilGive)
+{
+	pal_sem_t	sem = PAL_SEM_INITIALIZER(1, 0);
+	std::thread giver(
+		[&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			pal_sem_give(&sem);
+		});
+	EXPECT_EQ(0, pal_sem_take(&sem, PAL_OS_INFINITE_TIMEOUT));
+	EXPECT_EQ(0, pal_sem_get_count(&sem));
+	giver.join();
+}
+
+TEST(pal_os_sem, resourcePoolNeverExceedsCount)
+{
+	static pal_sem_t sem	   = PAL_SEM_INITIALIZER(3, 3);
+	int				 in_use	   = 0;
+	int				 max_inuse = 0;
+	auto			 worker	   = [&]()
+	{
+		for (int i = 0; i < 2000; i++)
+		{
+			EXPECT_EQ(0, pal_sem_take(&sem, PAL_OS_INFINITE_TIMEOUT));
+			int current = __atomic_add_fetch(&in_use, 1, __ATOMIC_SEQ_CST);
+			int seen	= __atomic_load_n(&max_inuse, __ATOMIC_SEQ_CST);
+			while (current > seen && !__atomic_compare_exchange_n(&max_inuse, &seen, current, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+			{
+			}
+			__atomic_sub_fetch(&in_use, 1, __ATOMIC_SEQ_CST);
+			EXPECT_EQ(0, pal_sem_give(&sem));
+		}
+	};
+	std::thread t1(worker);
+	std::thread t2(worker);
+	std::thread t3(worker);
+	std::thread t4(worker);
+	std::thread t5(worker);
+	t1.join();
+	t2.join();
+	t3.join();
+	t4.join();
+	t5.join();
+	EXPECT_LE(max_inuse, 3);
+	EXPECT_EQ(3, pal_sem_get_count(&sem));
+}
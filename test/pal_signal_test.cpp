@@ -18,6 +18,16 @@ TEST(pal_os_signal, createSignalFailure)
 	EXPECT_EQ(-1, pal_signal_create(nullptr));
 }
 
+TEST(pal_os_signal, staticInitializerNoCreate)
+{
+	static pal_signal_t signal			 = PAL_SIGNAL_INITIALIZER;
+	size_t				received_signals = 0;
+	EXPECT_EQ(0, pal_signal_set(&signal, (1 << 2)));
+	EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 2), &received_signals, 1, 0, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ((1 << 2), received_signals);
+	EXPECT_EQ(0, signal.signals);
+}
+
 TEST(pal_os_signal, destroySignalSuccess)
 {
 	pal_signal_t signal = {0};
@@ -186,3 +196,269 @@ TEST(pal_os_signal, WaitFiniteTimeoutFailure)
 
 	pal_signal_destroy(&signal);
 }
+
+TEST(pal_os_signal, SetWakesOnlyMatchingWaiter)
+{
+	pal_signal_t signal	   = PAL_SIGNAL_INITIALIZER;
+	size_t		 received1 = 0;
+	size_t		 received2 = 0;
+	std::thread	 waiter1([&]() { EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 1), &received1, 1, 0, 1000)); });
+	std::thread	 waiter2([&]() { EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 2) | (1 << 3), &received2, 1, 1, 1000)); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	// Each set satisfies exactly one waiter, the other one must keep waiting
+	EXPECT_EQ(0, pal_signal_set(&signal, (1 << 2) | (1 << 1)));
+	waiter1.join();
+	EXPECT_EQ((1 << 1), received1);
+	EXPECT_EQ((1 << 2), signal.signals);
+	EXPECT_EQ(0, pal_signal_set(&signal, (1 << 3)));
+	waiter2.join();
+	EXPECT_EQ((1 << 2) | (1 << 3), received2);
+	EXPECT_EQ(0, signal.signals);
+	EXPECT_EQ(nullptr, signal.waiters);
+}
+
+TEST(pal_os_signal, SetReleasesEveryWaiterOnClearedBit)
+{
+	pal_signal_t signal	   = PAL_SIGNAL_INITIALIZER;
+	size_t		 received1 = 0;
+	size_t		 received2 = 0;
+	std::thread	 waiter1([&]() { EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 4), &received1, 1, 0, 1000)); });
+	std::thread	 waiter2([&]() { EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 4), &received2, 0, 0, 1000)); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(0, pal_signal_set(&signal, (1 << 4)));
+	waiter1.join();
+	waiter2.join();
+	EXPECT_EQ((1 << 4), received1);
+	EXPECT_EQ((1 << 4), received2);
+	EXPECT_EQ(0, signal.signals);
+}
+
+TEST(pal_os_signal, PingPongNeverLosesWakeup)
+{
+	pal_signal_t signal = PAL_SIGNAL_INITIALIZER;
+	size_t		 rounds = 0;
+	std::thread	 ponger(
+		 [&]()
+		 {
+			 size_t received = 0;
+			 for (int i = 0; i < 10000; i++)
+			 {
+				 pal_signal_wait(&signal, (1 << 0), &received, 1, 0, PAL_OS_INFINITE_TIMEOUT);
+				 pal_signal_set(&signal, (1 << 1));
+			 }
+		 });
+	size_t received = 0;
+	for (int i = 0; i < 10000; i++)
+	{
+		pal_signal_set(&signal, (1 << 0));
+		if (PAL_SIGNAL_SUCCESS == pal_signal_wait(&signal, (1 << 1), &received, 1, 0, 1000))
+		{
+			rounds++;
+		}
+	}
+	ponger.join();
+	EXPECT_EQ(10000, rounds);
+	EXPECT_EQ(0, signal.signals);
+	EXPECT_EQ(nullptr, signal.waiters);
+}
+
+TEST(pal_os_signal, SyncFailure)
+{
+	pal_signal_t signal = PAL_SIGNAL_INITIALIZER;
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_sync(nullptr, (1 << 0), (1 << 0), PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_sync(&signal, (1 << 0), 0, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_TIMEOUT, pal_signal_sync(&signal, (1 << 0), (1 << 0) | (1 << 1), PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ((1 << 0), signal.signals);
+	EXPECT_EQ(PAL_SIGNAL_TIMEOUT, pal_signal_sync(&signal, 0, (1 << 0) | (1 << 1), 50));
+	EXPECT_EQ(nullptr, signal.waiters);
+	EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_sync(&signal, (1 << 1), (1 << 0) | (1 << 1), PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, signal.signals);
+}
+
+TEST(pal_os_signal, SyncAlignsPhases)
+{
+	pal_signal_t signal	  = PAL_SIGNAL_INITIALIZER;
+	int			 phase[3] = {0, 0, 0};
+	int			 skew	  = 0;
+	auto		 worker	  = [&](int id)
+	{
+		for (int i = 1; i <= 1000; i++)
+		{
+			__atomic_store_n(&phase[id], i, __ATOMIC_RELAXED);
+			EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_sync(&signal, (size_t)1 << id, 0x7, PAL_OS_INFINITE_TIMEOUT));
+			// Every party reached this cycle before anyone is released
+			for (int other = 0; other < 3; other++)
+			{
+				if (__atomic_load_n(&phase[other], __ATOMIC_RELAXED) < i)
+				{
+					__atomic_fetch_add(&skew, 1, __ATOMIC_RELAXED);
+				}
+			}
+			// Second rendezvous so no party starts the next cycle while another is still checking this one
+			EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_sync(&signal, (size_t)1 << (id + 3), 0x38, PAL_OS_INFINITE_TIMEOUT));
+		}
+	};
+	std::thread t0(worker, 0);
+	std::thread t1(worker, 1);
+	std::thread t2(worker, 2);
+	t0.join();
+	t1.join();
+	t2.join();
+	EXPECT_EQ(0, skew);
+	EXPECT_EQ(0, signal.signals);
+}
+
+TEST(pal_os_signal, WaitMultiFailure)
+{
+	pal_signal_t			signal	   = PAL_SIGNAL_INITIALIZER;
+	size_t					index	   = 0;
+	pal_signal_wait_entry_t entries[2] = {};
+	entries[0].signal				   = &signal;
+	entries[0].mask					   = (1 << 0);
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_wait_multi(nullptr, 1, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_wait_multi(entries, 0, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_wait_multi(entries, 1, nullptr, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_FAILURE, pal_signal_wait_multi(entries, 2, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_TIMEOUT, pal_signal_wait_multi(entries, 1, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(PAL_SIGNAL_TIMEOUT, pal_signal_wait_multi(entries, 1, &index, 50));
+	EXPECT_EQ(nullptr, signal.waiters);
+}
+
+TEST(pal_os_signal, WaitMultiReportsFirstSatisfiedEntry)
+{
+	pal_signal_t			signal1	   = PAL_SIGNAL_INITIALIZER;
+	pal_signal_t			signal2	   = PAL_SIGNAL_INITIALIZER;
+	size_t					index	   = 0;
+	pal_signal_wait_entry_t entries[2] = {};
+	entries[0].signal				   = &signal1;
+	entries[0].mask					   = (1 << 0) | (1 << 1);
+	entries[0].wait_all				   = 1;
+	entries[1].signal				   = &signal2;
+	entries[1].mask					   = (1 << 2);
+	entries[1].clear_mask			   = 1;
+	pal_signal_set(&signal1, (1 << 0));
+	pal_signal_set(&signal2, (1 << 2));
+	EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait_multi(entries, 2, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(1, index);
+	EXPECT_EQ((1 << 2), entries[1].received_signals);
+	EXPECT_EQ(0, signal2.signals);
+	pal_signal_set(&signal1, (1 << 1));
+	pal_signal_set(&signal2, (1 << 2));
+	EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait_multi(entries, 2, &index, PAL_OS_NO_TIMEOUT));
+	EXPECT_EQ(0, index);
+	EXPECT_EQ((1 << 0) | (1 << 1), entries[0].received_signals);
+	EXPECT_EQ((1 << 2), signal2.signals);
+	EXPECT_EQ(nullptr, signal1.waiters);
+	EXPECT_EQ(nullptr, signal2.waiters);
+}
+
+TEST(pal_os_signal, WaitMultiWokenBySet)
+{
+	pal_signal_t			signals[3] = {PAL_SIGNAL_INITIALIZER, PAL_SIGNAL_INITIALIZER, PAL_SIGNAL_INITIALIZER};
+	size_t					index	   = 0;
+	pal_signal_wait_entry_t entries[3] = {};
+	for (int i = 0; i < 3; i++)
+	{
+		entries[i].signal	  = &signals[i];
+		entries[i].mask		  = (1 << i);
+		entries[i].clear_mask = 1;
+	}
+	std::thread setter(
+		[&]()
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			pal_signal_set(&signals[2], (1 << 2));
+		});
+	EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait_multi(entries, 3, &index, 1000));
+	setter.join();
+	EXPECT_EQ(2, index);
+	EXPECT_EQ((1 << 2), entries[2].received_signals);
+	EXPECT_EQ(0, signals[2].signals);
+	for (int i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(nullptr, signals[i].waiters);
+	}
+}
+
+TEST(pal_os_signal, WaitMultiWithConcurrentSets)
+{
+	pal_signal_t signal1  = PAL_SIGNAL_INITIALIZER;
+	pal_signal_t signal2  = PAL_SIGNAL_INITIALIZER;
+	int			 stop	  = 0;
+	size_t		 consumed = 0;
+	auto		 setter	  = [&](pal_signal_t *signal)
+	{
+		while (!__atomic_load_n(&stop, __ATOMIC_ACQUIRE))
+		{
+			pal_signal_set(signal, (1 << 0));
+		}
+	};
+	std::thread				t1(setter, &signal1);
+	std::thread				t2(setter, &signal2);
+	pal_signal_wait_entry_t entries[2] = {};
+	entries[0].signal				   = &signal1;
+	entries[0].mask					   = (1 << 0);
+	entries[0].clear_mask			   = 1;
+	entries[1].signal				   = &signal2;
+	entries[1].mask					   = (1 << 0);
+	entries[1].clear_mask			   = 1;
+	for (int i = 0; i < 10000; i++)
+	{
+		size_t index = 0;
+		if (PAL_SIGNAL_SUCCESS == pal_signal_wait_multi(entries, 2, &index, 1000))
+		{
+			consumed++;
+		}
+	}
+	__atomic_store_n(&stop, 1, __ATOMIC_RELEASE);
+	t1.join();
+	t2.join();
+	EXPECT_EQ(10000, consumed);
+	EXPECT_EQ(nullptr, signal1.waiters);
+	EXPECT_EQ(nullptr, signal2.waiters);
+}
+
+TEST(pal_os_signal, StatsFailure)
+{
+	pal_signal_t	   signal = PAL_SIGNAL_INITIALIZER;
+	pal_signal_stats_t stats  = {};
+	EXPECT_EQ(-1, pal_signal_enable_stats(nullptr, &stats));
+	EXPECT_EQ(-1, pal_signal_get_stats(&signal, &stats));
+	EXPECT_EQ(0, pal_signal_enable_stats(&signal, &stats));
+	EXPECT_EQ(-1, pal_signal_get_stats(&signal, nullptr));
+	EXPECT_EQ(0, pal_signal_enable_stats(&signal, nullptr));
+	EXPECT_EQ(-1, pal_signal_get_stats(&signal, &stats));
+}
+
+TEST(pal_os_signal, StatsCountOperationsAndLatency)
+{
+	pal_signal_t	   signal	= PAL_SIGNAL_INITIALIZER;
+	pal_signal_stats_t storage	= {};
+	pal_signal_stats_t snapshot = {};
+	size_t			   received = 0;
+	EXPECT_EQ(0, pal_signal_enable_stats(&signal, &storage));
+	pal_signal_set(&signal, (1 << 0));
+	pal_signal_clear(&signal, (1 << 0));
+	EXPECT_EQ(PAL_SIGNAL_TIMEOUT, pal_signal_wait(&signal, (1 << 1), &received, 0, 0, 10));
+
+	std::thread waiter([&]() { EXPECT_EQ(PAL_SIGNAL_SUCCESS, pal_signal_wait(&signal, (1 << 2), &received, 1, 0, 1000)); });
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	EXPECT_EQ(0, pal_signal_get_stats(&signal, &snapshot));
+	EXPECT_EQ(1, snapshot.waiters);
+	pal_signal_set(&signal, (1 << 2));
+	waiter.join();
+
+	EXPECT_EQ(0, pal_signal_get_stats(&signal, &snapshot));
+	EXPECT_EQ(2, snapshot.sets);
+	EXPECT_EQ(1, snapshot.clears);
+	EXPECT_EQ(2, snapshot.waits);
+	EXPECT_EQ(0, snapshot.waiters);
+	EXPECT_EQ(1, snapshot.timeouts);
+	size_t wakeups = 0;
+	for (size_t i = 0; i < PAL_SIGNAL_LATENCY_BUCKETS; i++)
+	{
+		wakeups += snapshot.wake_latency_us[i];
+	}
+	EXPECT_EQ(1, wakeups);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "pal_os/common.h"
 #include "pal_os/thread.h"
 #include "thread_priv.h"
 
@@ -101,4 +102,83 @@ TEST(pal_os_thread, threadSleep)
 	pal_thread_sleep(1000);
 	time_t end_time = time(NULL);
 	EXPECT_EQ(1, end_time - start_time);
-}
\ No newline at end of file
+}
+typedef struct notify_test_ctx_s
+{
+	uint32_t clear_on_exit;
+	size_t	 timeout_ms;
+	int		 ret_code;
+	uint32_t	  value;
+	pal_thread_t *self;
+} notify_test_ctx_t;
+
+void notify_wait_function(void *arg)
+{
+	notify_test_ctx_t *ctx = (notify_test_ctx_t *)arg;
+	ctx->ret_code		   = pal_thread_notify_wait(0, ctx->clear_on_exit, &ctx->value, ctx->timeout_ms);
+}
+
+TEST(pal_os_thread, notifyNullThreadFailure) { EXPECT_EQ(-1, pal_thread_notify(nullptr, 1, PAL_THREAD_NOTIFY_SET_BITS)); }
+
+TEST(pal_os_thread, notifyWaitFromForeignThreadFailure)
+{
+	uint32_t value = 0;
+	EXPECT_EQ(-1, pal_thread_notify_wait(0, 0, &value, PAL_OS_NO_TIMEOUT));
+}
+
+TEST(pal_os_thread, notifySetBitsWakesWaiter)
+{
+	pal_thread_t	  thread = {0};
+	notify_test_ctx_t ctx	 = {0xFFFFFFFF, PAL_OS_INFINITE_TIMEOUT, -1, 0, nullptr};
+	EXPECT_EQ(0, pal_thread_create(&thread, PAL_THREAD_PRIORITY_NORMAL, 1024, notify_wait_function, "Notified", &ctx));
+	pal_thread_sleep(50);
+	EXPECT_EQ(0, pal_thread_notify(&thread, (1 << 2), PAL_THREAD_NOTIFY_SET_BITS));
+	pal_thread_join(&thread);
+	EXPECT_EQ(0, ctx.ret_code);
+	EXPECT_EQ((1 << 2), ctx.value);
+	EXPECT_EQ(0, thread.notify_value);
+}
+
+TEST(pal_os_thread, notifyActionsUpdateValue)
+{
+	pal_thread_t thread = {0};
+	EXPECT_EQ(0, pal_thread_notify(&thread, 0, PAL_THREAD_NOTIFY_INCREMENT));
+	EXPECT_EQ(0, pal_thread_notify(&thread, 0, PAL_THREAD_NOTIFY_INCREMENT));
+	EXPECT_EQ(2, thread.notify_value);
+	EXPECT_EQ(0, pal_thread_notify(&thread, (1 << 4), PAL_THREAD_NOTIFY_SET_BITS));
+	EXPECT_EQ((1 << 4) | 2, thread.notify_value);
+	EXPECT_EQ(0, pal_thread_notify(&thread, 7, PAL_THREAD_NOTIFY_OVERWRITE));
+	EXPECT_EQ(7, thread.notify_value);
+	EXPECT_EQ(-1, pal_thread_notify(&thread, 7, (pal_thread_notify_action_t)0xFF));
+}
+
+void notify_self_function(void *arg)
+{
+	notify_test_ctx_t *ctx = (notify_test_ctx_t *)arg;
+	pal_thread_notify(ctx->self, 5, PAL_THREAD_NOTIFY_OVERWRITE);
+	ctx->ret_code = pal_thread_notify_wait(0xFFFFFFFF, ctx->clear_on_exit, &ctx->value, PAL_OS_NO_TIMEOUT);
+}
+
+TEST(pal_os_thread, notifyPendingBeforeWaitSuccess)
+{
+	pal_thread_t	  thread = {0};
+	notify_test_ctx_t ctx	 = {0, PAL_OS_NO_TIMEOUT, -1, 0, &thread};
+	EXPECT_EQ(0, pal_thread_create(&thread, PAL_THREAD_PRIORITY_NORMAL, 1024, notify_self_function, "Notified", &ctx));
+	pal_thread_join(&thread);
+	// A pending notification is consumed without blocking and clear_on_entry is not applied
+	EXPECT_EQ(0, ctx.ret_code);
+	EXPECT_EQ(5, ctx.value);
+	EXPECT_EQ(5, thread.notify_value);
+}
+
+TEST(pal_os_thread, notifyWaitTimeout)
+{
+	pal_thread_t	  thread = {0};
+	notify_test_ctx_t ctx	 = {0, 100, 0, 0, nullptr};
+	EXPECT_EQ(0, pal_thread_create(&thread, PAL_THREAD_PRIORITY_NORMAL, 1024, notify_wait_function, "Notified", &ctx));
+	pal_thread_join(&thread);
+	EXPECT_EQ(-1, ctx.ret_code);
+	EXPECT_EQ(0, thread.notify_state);
+	EXPECT_EQ(0, pal_thread_notify(&thread, 3, PAL_THREAD_NOTIFY_OVERWRITE));
+	EXPECT_EQ(3, thread.notify_value);
+}
@@ -0,0 +1,119 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "timer_priv.h"
+
+static uint64_t nowUs(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+static uint64_t jitterStartUs = 0;
+static int		jitterRuns	  = 0;
+static uint64_t jitterSumUs	  = 0;
+static uint64_t jitterMaxUs	  = 0;
+static void		jitterCallback(pal_timer_t *arg)
+{
+	// The periods stay on the grid started at creation, a run is late by its distance from the last grid point
+	uint64_t late = (nowUs() - jitterStartUs) % 5000;
+	jitterRuns++;
+	jitterSumUs += late;
+	jitterMaxUs = late > jitterMaxUs ? late : jitterMaxUs;
+}
+
+// Runs a 5 ms periodic timer for 500 ms and prints how late its callbacks ran
+static void measureWakeupJitter(int use_timerfd, const char *name)
+{
+	jitterRuns	= 0;
+	jitterSumUs = 0;
+	jitterMaxUs = 0;
+	pal_timer_deinit();
+	pal_timer_environment[0].use_timerfd = use_timerfd;
+	pal_timer_t timer					 = {0};
+	pal_timer_init();
+	jitterStartUs = nowUs();
+	pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 5, jitterCallback, 1, nullptr);
+	usleep(502000);
+	pal_timer_delete(&timer);
+	pal_timer_deinit();
+	pal_timer_environment[0].use_timerfd = PAL_TIMER_USE_TIMERFD;
+	if (jitterRuns)
+	{
+		printf("%s wakeup: %d runs, mean lateness %llu us, max lateness %llu us\n", name, jitterRuns, (unsigned long long)(jitterSumUs / jitterRuns),
+			   (unsigned long long)jitterMaxUs);
+	}
+}
+
+static int	wakeupRuns = 0;
+static void wakeupCallback(pal_timer_t *arg) { wakeupRuns++; }
+
+// Runs ten staggered 20 ms periodic timers for 500 ms and returns how often the service woke up
+static size_t countWakeups(size_t slack_ms)
+{
+	wakeupRuns = 0;
+	pal_timer_deinit();
+	pal_timer_t timers[10] = {};
+	pal_timer_init();
+	for (int i = 0; i < 10; i++)
+	{
+		// Staggered phases, each timer alone would wake the thread every 2 ms
+		pal_timer_create(&timers[i], "", PAL_TIMER_TYPE_PERIODIC, 20, wakeupCallback, 0, nullptr);
+		pal_timer_set_slack(&timers[i], slack_ms);
+		pal_timer_start(&timers[i]);
+		usleep(2000);
+	}
+	size_t wakeups = pal_timer_environment[0].wakeups;
+	usleep(500000);
+	wakeups = pal_timer_environment[0].wakeups - wakeups;
+	for (int i = 0; i < 10; i++)
+	{
+		pal_timer_stop(&timers[i]);
+	}
+	pal_timer_deinit();
+	return wakeups;
+}
+
+static uint64_t fastStartUs = 0;
+static int		fastRuns	= 0;
+static uint64_t fastSumUs	= 0;
+static void		fastCallback(pal_timer_t *arg)
+{
+	fastRuns++;
+	fastSumUs += (nowUs() - fastStartUs) % 250;
+}
+
+// Runs a 250 us periodic timer spinning for its last 100 us for 500 ms and prints how late its callbacks ran
+static void measureMicrosecondPeriod(void)
+{
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	pal_timer_create_us(&timer, "", PAL_TIMER_TYPE_PERIODIC, 250, fastCallback, 0, nullptr);
+	pal_timer_set_spin(&timer, 100);
+	fastStartUs = nowUs();
+	pal_timer_start(&timer);
+	usleep(500000);
+	pal_timer_delete(&timer);
+	pal_timer_deinit();
+	// Missed periods are skipped, a loaded machine runs fewer than the 2000 periods that elapsed
+	if (fastRuns)
+	{
+		printf("250 us period: %d runs in 500 ms, mean lateness %llu us\n", fastRuns, (unsigned long long)(fastSumUs / fastRuns));
+	}
+}
+
+// The figures depend on the host and its load, so they are printed here instead of being asserted by the unit tests
+int main(void)
+{
+	measureWakeupJitter(1, "timerfd");
+	measureWakeupJitter(0, "condition variable");
+	size_t exact	 = countWakeups(0);
+	size_t coalesced = countWakeups(20);
+	printf("wakeups in 500 ms: %zu exact, %zu with 20 ms slack\n", exact, coalesced);
+	measureMicrosecondPeriod();
+	return 0;
+}
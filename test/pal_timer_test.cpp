@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 #include "timer_priv.h"
 
 static int timerCounter = 0;
@@ -28,228 +31,750 @@ TEST(pal_timer, compareSameTimes)
 TEST(pal_timer, killThreadNoTimers)
 {
 	EXPECT_EQ(0, pal_timer_init());
-	EXPECT_EQ(0, pal_timer_environment.shutdown_flag);
-	EXPECT_NE(0, pal_timer_environment.thread_handle);
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
+	EXPECT_EQ(0, pal_timer_environment[0].shutdown_flag);
+	EXPECT_NE(0, pal_timer_environment[0].thread_handle);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 	pal_timer_deinit();
-	EXPECT_EQ(0, pal_timer_environment.thread_handle);
+	EXPECT_EQ(0, pal_timer_environment[0].thread_handle);
 }
 
-TEST(pal_timer, add3TimersSorted)
+static void expectHeapOrdered(void)
 {
-	pal_timer_environment.timer_list = nullptr;
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
+	for (size_t i = 0; i < pal_timer_environment[0].heap_size; i++)
+	{
+		EXPECT_EQ(i, pal_timer_environment[0].heap[i]->heap_index);
+		if (i)
+		{
+			EXPECT_LE(pal_os_timer_time_cmp(&pal_timer_environment[0].heap[(i - 1) / 2]->latest_time, &pal_timer_environment[0].heap[i]->latest_time), 0);
+		}
+	}
+}
 
-	pal_timer_t *timer1 = (pal_timer_t *)malloc(sizeof(pal_timer_t));
-	pal_timer_t *timer2 = (pal_timer_t *)malloc(sizeof(pal_timer_t));
-	pal_timer_t *timer3 = (pal_timer_t *)malloc(sizeof(pal_timer_t));
+TEST(pal_timer, add3TimersSorted)
+{
+	pal_timer_deinit();
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 
-	timer1->expiry_time.tv_sec	= 1;
-	timer1->expiry_time.tv_nsec = 0;
-	timer2->expiry_time.tv_sec	= 2;
-	timer2->expiry_time.tv_nsec = 0;
-	timer3->expiry_time.tv_sec	= 3;
-	timer3->expiry_time.tv_nsec = 0;
+	pal_timer_t timer1 = {};
+	pal_timer_t timer2 = {};
+	pal_timer_t timer3 = {};
 
-	pal_os_timer_insert_sorted(timer1);
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
+	timer1.expiry_time.tv_sec = 1;
+	timer2.expiry_time.tv_sec = 2;
+	timer3.expiry_time.tv_sec = 3;
 
-	pal_os_timer_insert_sorted(timer2);
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer2, timer1->next);
+	EXPECT_EQ(0, pal_os_timer_heap_insert(&timer1));
+	EXPECT_EQ(&timer1, pal_os_timer_heap_top(&pal_timer_environment[0]));
 
-	pal_os_timer_insert_sorted(timer3);
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer2, timer1->next);
-	EXPECT_EQ(timer3, timer2->next);
-	EXPECT_EQ(nullptr, timer3->next);
+	EXPECT_EQ(0, pal_os_timer_heap_insert(&timer2));
+	EXPECT_EQ(&timer1, pal_os_timer_heap_top(&pal_timer_environment[0]));
 
-	free(timer1);
-	free(timer2);
-	free(timer3);
+	EXPECT_EQ(0, pal_os_timer_heap_insert(&timer3));
+	EXPECT_EQ(&timer1, pal_os_timer_heap_top(&pal_timer_environment[0]));
+	EXPECT_EQ(3, pal_timer_environment[0].heap_size);
+	expectHeapOrdered();
+	pal_timer_deinit();
 }
 
 TEST(pal_timer, add5TimersNotSorted)
 {
-	pal_timer_environment.timer_list = nullptr;
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
-
-	pal_timer_t *timer1 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer2 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer3 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer4 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer5 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-
-	timer1->expiry_time.tv_sec	= 1;
-	timer1->expiry_time.tv_nsec = 5241;
-	timer2->expiry_time.tv_sec	= 2;
-	timer2->expiry_time.tv_nsec = 215141;
-	timer3->expiry_time.tv_sec	= 3;
-	timer3->expiry_time.tv_nsec = 321312312;
-	timer4->expiry_time.tv_sec	= 3;
-	timer4->expiry_time.tv_nsec = 214;
-	timer5->expiry_time.tv_sec	= 1;
-	timer5->expiry_time.tv_nsec = 425252;
-
-	pal_os_timer_insert_sorted(timer3);
-	pal_os_timer_insert_sorted(timer2);
-	pal_os_timer_insert_sorted(timer5);
-	pal_os_timer_insert_sorted(timer1);
-	pal_os_timer_insert_sorted(timer4);
-
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer5, timer1->next);
-	EXPECT_EQ(timer2, timer5->next);
-	EXPECT_EQ(timer4, timer2->next);
-	EXPECT_EQ(timer3, timer4->next);
-	EXPECT_EQ(nullptr, timer3->next);
-	free(timer1);
-	free(timer2);
-	free(timer3);
-	free(timer4);
-	free(timer5);
+	pal_timer_deinit();
+	pal_timer_t timers[5]	 = {};
+	long		seconds[5]	 = {1, 2, 3, 3, 1};
+	long		nanos[5]	 = {5241, 215141, 321312312, 214, 425252};
+	int			order[5]	 = {0, 4, 1, 3, 2};
+	int			insertion[5] = {2, 1, 4, 0, 3};
+	for (int i = 0; i < 5; i++)
+	{
+		timers[i].expiry_time.tv_sec  = seconds[i];
+		timers[i].expiry_time.tv_nsec = nanos[i];
+	}
+	for (int i = 0; i < 5; i++)
+	{
+		EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[insertion[i]]));
+		expectHeapOrdered();
+	}
+
+	// Popping the top yields the timers by expiry time
+	for (int i = 0; i < 5; i++)
+	{
+		EXPECT_EQ(&timers[order[i]], pal_os_timer_heap_top(&pal_timer_environment[0]));
+		pal_os_timer_heap_remove(pal_os_timer_heap_top(&pal_timer_environment[0]));
+		expectHeapOrdered();
+	}
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
+	pal_timer_deinit();
 }
 
 TEST(pal_timer, removeTimer)
 {
-	pal_timer_environment.timer_list = nullptr;
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
-
-	pal_timer_t *timer1 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer2 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer3 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer4 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer5 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-
-	timer1->expiry_time.tv_sec	= 1;
-	timer1->expiry_time.tv_nsec = 5241;
-	timer2->expiry_time.tv_sec	= 2;
-	timer2->expiry_time.tv_nsec = 215141;
-	timer3->expiry_time.tv_sec	= 3;
-	timer3->expiry_time.tv_nsec = 321312312;
-	timer4->expiry_time.tv_sec	= 3;
-	timer4->expiry_time.tv_nsec = 214;
-	timer5->expiry_time.tv_sec	= 1;
-	timer5->expiry_time.tv_nsec = 425252;
-
-	pal_os_timer_insert_sorted(timer3);
-	pal_os_timer_insert_sorted(timer2);
-	pal_os_timer_insert_sorted(timer5);
-	pal_os_timer_insert_sorted(timer1);
-	pal_os_timer_insert_sorted(timer4);
-
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer5, timer1->next);
-	EXPECT_EQ(timer2, timer5->next);
-	EXPECT_EQ(timer4, timer2->next);
-	EXPECT_EQ(timer3, timer4->next);
-	EXPECT_EQ(nullptr, timer3->next);
-
-	pal_os_timer_remove(timer3);
-
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer5, timer1->next);
-	EXPECT_EQ(timer2, timer5->next);
-	EXPECT_EQ(timer4, timer2->next);
-	EXPECT_EQ(nullptr, timer4->next);
-
-	pal_os_timer_remove(timer2);
-
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer5, timer1->next);
-	EXPECT_EQ(timer4, timer5->next);
-	EXPECT_EQ(nullptr, timer4->next);
-
-	pal_os_timer_remove(timer1);
-
-	EXPECT_EQ(timer5, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer4, timer5->next);
-	EXPECT_EQ(nullptr, timer4->next);
-
-	free(timer1);
-	free(timer2);
-	free(timer3);
-	free(timer4);
-	free(timer5);
+	pal_timer_deinit();
+	pal_timer_t timers[5]  = {};
+	pal_timer_t not_queued = {};
+	long		seconds[5] = {1, 2, 3, 3, 1};
+	long		nanos[5]   = {5241, 215141, 321312312, 214, 425252};
+	for (int i = 0; i < 5; i++)
+	{
+		timers[i].expiry_time.tv_sec  = seconds[i];
+		timers[i].expiry_time.tv_nsec = nanos[i];
+		EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[i]));
+	}
+
+	pal_os_timer_heap_remove(&timers[2]);
+	EXPECT_EQ(4, pal_timer_environment[0].heap_size);
+	expectHeapOrdered();
+
+	// Removing a timer that is not queued, or twice, has no effect
+	pal_os_timer_heap_remove(&not_queued);
+	pal_os_timer_heap_remove(&timers[2]);
+	EXPECT_EQ(4, pal_timer_environment[0].heap_size);
+
+	pal_os_timer_heap_remove(&timers[0]);
+	EXPECT_EQ(&timers[4], pal_os_timer_heap_top(&pal_timer_environment[0]));
+	expectHeapOrdered();
+
+	// Rescheduling moves the timer to its new position
+	timers[1].expiry_time.tv_sec = 0;
+	pal_os_timer_heap_update(&timers[1]);
+	EXPECT_EQ(&timers[1], pal_os_timer_heap_top(&pal_timer_environment[0]));
+	expectHeapOrdered();
+	timers[1].expiry_time.tv_sec = 10;
+	pal_os_timer_heap_update(&timers[1]);
+	EXPECT_EQ(&timers[4], pal_os_timer_heap_top(&pal_timer_environment[0]));
+	expectHeapOrdered();
+	pal_timer_deinit();
+}
+
+TEST(pal_timer, growHeap)
+{
+	pal_timer_deinit();
+	pal_timer_t timers[4 * PAL_TIMER_HEAP_INITIAL_CAPACITY] = {};
+	for (size_t i = 0; i < 4 * PAL_TIMER_HEAP_INITIAL_CAPACITY; i++)
+	{
+		timers[i].expiry_time.tv_sec = (long)((i * 7919) % 1000);
+		EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[i]));
+	}
+	EXPECT_LE(4 * PAL_TIMER_HEAP_INITIAL_CAPACITY, pal_timer_environment[0].heap_capacity);
+	expectHeapOrdered();
+	pal_timer_deinit();
+}
+
+static struct timespec msToTime(uint64_t ms)
+{
+	struct timespec time = {(time_t)(ms / 1000), (long)((ms % 1000) * 1000000)};
+	return time;
+}
+
+static uint64_t nowUs(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+}
+
+TEST(pal_timer, wheelAdvance)
+{
+	pal_timer_deinit();
+	pal_timer_t		timers[3] = {};
+	struct timespec now		  = msToTime(0);
+	// The second and third timers share a slot, one wheel revolution apart
+	timers[0].expiry_time = msToTime(PAL_TIMER_WHEEL_TICK_MS / 2);
+	timers[1].expiry_time = msToTime(3 * PAL_TIMER_WHEEL_TICK_MS);
+	timers[2].expiry_time = msToTime((3 + PAL_TIMER_WHEEL_SLOTS) * PAL_TIMER_WHEEL_TICK_MS);
+	for (int i = 0; i < 3; i++)
+	{
+		pal_os_timer_wheel_insert(&timers[i], &now);
+	}
+	EXPECT_EQ(3, pal_timer_environment[0].wheel_size);
+
+	// Deadlines are rounded up to the next tick
+	now = msToTime(PAL_TIMER_WHEEL_TICK_MS - 1);
+	EXPECT_EQ(0, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	now = msToTime(PAL_TIMER_WHEEL_TICK_MS);
+	EXPECT_EQ(1, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	EXPECT_EQ(&timers[0], pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(nullptr, pal_os_timer_expired_pop(&pal_timer_environment[0]));
+
+	// Only the timer of the current revolution leaves the shared slot
+	now = msToTime(3 * PAL_TIMER_WHEEL_TICK_MS);
+	EXPECT_EQ(1, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	EXPECT_EQ(&timers[1], pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(1, pal_timer_environment[0].wheel_size);
+
+	// Removing a timer that is not on the wheel has no effect
+	pal_os_timer_wheel_remove(&timers[1]);
+	EXPECT_EQ(1, pal_timer_environment[0].wheel_size);
+	pal_os_timer_wheel_remove(&timers[2]);
+	EXPECT_EQ(0, pal_timer_environment[0].wheel_size);
+	now = msToTime((4 + PAL_TIMER_WHEEL_SLOTS) * PAL_TIMER_WHEEL_TICK_MS);
+	EXPECT_EQ(0, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	pal_timer_deinit();
+}
+
+TEST(pal_timer, wheelAdvanceAfterLongSleep)
+{
+	pal_timer_deinit();
+	pal_timer_t		timers[PAL_TIMER_WHEEL_SLOTS] = {};
+	struct timespec now							  = msToTime(0);
+	for (size_t i = 0; i < PAL_TIMER_WHEEL_SLOTS; i++)
+	{
+		timers[i].expiry_time = msToTime((i + 1) * PAL_TIMER_WHEEL_TICK_MS);
+		pal_os_timer_wheel_insert(&timers[i], &now);
+	}
+	// Every slot is visited once, however many ticks elapsed
+	now = msToTime(10 * PAL_TIMER_WHEEL_SLOTS * PAL_TIMER_WHEEL_TICK_MS);
+	EXPECT_EQ(PAL_TIMER_WHEEL_SLOTS, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	EXPECT_EQ(0, pal_timer_environment[0].wheel_size);
+	pal_timer_deinit();
+}
+
+TEST(pal_timer, deinitDetachesWheelTimers)
+{
+	pal_timer_deinit();
+	pal_timer_t		timers[3] = {};
+	struct timespec now		  = msToTime(0);
+	for (int i = 0; i < 3; i++)
+	{
+		timers[i].expiry_time = msToTime((i + 1) * PAL_TIMER_WHEEL_TICK_MS);
+		timers[i].is_started  = 1;
+		pal_os_timer_wheel_insert(&timers[i], &now);
+	}
+	now = msToTime(PAL_TIMER_WHEEL_TICK_MS);
+	EXPECT_EQ(1, pal_os_timer_wheel_advance(&pal_timer_environment[0], &now));
+	pal_timer_deinit();
+	// The timers left on the wheel and in the expired list are dropped with them, stopping them later touches nothing
+	for (int i = 0; i < 3; i++)
+	{
+		EXPECT_EQ(PAL_TIMER_QUEUE_NONE, timers[i].queue);
+		EXPECT_EQ(0, timers[i].is_started);
+		EXPECT_EQ(0, pal_timer_stop(&timers[i]));
+	}
+	EXPECT_EQ(0, pal_timer_environment[0].wheel_size);
+	EXPECT_EQ(nullptr, pal_timer_environment[0].expired_head);
+	for (size_t slot = 0; slot < PAL_TIMER_WHEEL_SLOTS; slot++)
+	{
+		EXPECT_EQ(nullptr, pal_timer_environment[0].wheel[slot]);
+	}
+}
+
+TEST(pal_timer, heapExpire)
+{
+	pal_timer_deinit();
+	pal_timer_t timers[4]  = {};
+	long		seconds[4] = {3, 1, 2, 1};
+	for (int i = 0; i < 4; i++)
+	{
+		timers[i].expiry_time.tv_sec = seconds[i];
+		EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[i]));
+	}
+	// Every timer due at the clock sample leaves the heap in one call, by expiry time
+	struct timespec now = msToTime(2000);
+	EXPECT_EQ(3, pal_os_timer_heap_expire(&pal_timer_environment[0], &now));
+	EXPECT_EQ(&timers[0], pal_os_timer_heap_top(&pal_timer_environment[0]));
+	EXPECT_EQ(1, pal_timer_environment[0].heap_size);
+	pal_timer_t *first = pal_os_timer_expired_pop(&pal_timer_environment[0]);
+	EXPECT_TRUE(&timers[1] == first || &timers[3] == first);
+	EXPECT_NE(nullptr, pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(&timers[2], pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(nullptr, pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(0, pal_os_timer_heap_expire(&pal_timer_environment[0], &now));
+	pal_timer_deinit();
+}
+
+TEST(pal_timer, heapExpireWithSlack)
+{
+	pal_timer_deinit();
+	pal_timer_t timers[2]		 = {};
+	timers[0].expiry_time.tv_sec = 1;
+	timers[0].slack_ms			 = 5000;
+	timers[1].expiry_time.tv_sec = 2;
+	EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[0]));
+	EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[1]));
+	// The heap is ordered by the end of the slack windows
+	EXPECT_EQ(&timers[1], pal_os_timer_heap_top(&pal_timer_environment[0]));
+	EXPECT_EQ(6, timers[0].latest_time.tv_sec);
+	struct timespec now = msToTime(1500);
+	EXPECT_EQ(0, pal_os_timer_heap_expire(&pal_timer_environment[0], &now));
+	// The wakeup for the second timer also runs the first one, whose window is open
+	now = msToTime(2000);
+	EXPECT_EQ(2, pal_os_timer_heap_expire(&pal_timer_environment[0], &now));
+	EXPECT_EQ(&timers[1], pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	EXPECT_EQ(&timers[0], pal_os_timer_expired_pop(&pal_timer_environment[0]));
+	pal_timer_deinit();
 }
 
 TEST(pal_timer, killThreadWithTimers)
 {
-	pal_timer_environment.timer_list = nullptr;
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
-
-	pal_timer_t *timer1 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer2 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer3 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer4 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-	pal_timer_t *timer5 = (pal_timer_t *)calloc(1, sizeof(pal_timer_t));
-
-	timer1->expiry_time.tv_sec	= 1;
-	timer1->expiry_time.tv_nsec = 5241;
-	timer2->expiry_time.tv_sec	= 2;
-	timer2->expiry_time.tv_nsec = 215141;
-	timer3->expiry_time.tv_sec	= 3;
-	timer3->expiry_time.tv_nsec = 321312312;
-	timer4->expiry_time.tv_sec	= 3;
-	timer4->expiry_time.tv_nsec = 214;
-	timer5->expiry_time.tv_sec	= 1;
-	timer5->expiry_time.tv_nsec = 425252;
-
-	pal_os_timer_insert_sorted(timer2);
-	pal_os_timer_insert_sorted(timer3);
-	pal_os_timer_insert_sorted(timer5);
-	pal_os_timer_insert_sorted(timer1);
-	pal_os_timer_insert_sorted(timer4);
-
-	EXPECT_EQ(timer1, pal_timer_environment.timer_list);
-	EXPECT_EQ(timer5, timer1->next);
-	EXPECT_EQ(timer2, timer5->next);
-	EXPECT_EQ(timer4, timer2->next);
-	EXPECT_EQ(timer3, timer4->next);
+	pal_timer_deinit();
+	pal_timer_t timers[5] = {};
+	for (int i = 0; i < 5; i++)
+	{
+		// Far enough in the future that none expires before the thread is killed
+		timers[i].callback			 = timerCallback;
+		timers[i].expiry_time.tv_sec = 1000000 + i;
+		EXPECT_EQ(0, pal_os_timer_heap_insert(&timers[i]));
+	}
 	pal_timer_init();
-	EXPECT_NE(0, pal_timer_environment.thread_handle);
+	EXPECT_NE(0, pal_timer_environment[0].thread_handle);
 	pal_timer_deinit();
-	EXPECT_EQ(0, pal_timer_environment.thread_handle);
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
-	free(timer1);
-	free(timer2);
-	free(timer3);
-	free(timer4);
-	free(timer5);
+	EXPECT_EQ(0, pal_timer_environment[0].thread_handle);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 }
 
 TEST(pal_timer, createTimerAutoStartOneShot)
 {
-	timerCounter					 = 0;
-	pal_timer_environment.timer_list = nullptr;
-	pal_timer_t timer				 = {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 300, timerCallback, 1, nullptr));
 	sleep(1);
 	EXPECT_EQ(1, timerCounter);
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 	pal_timer_deinit();
 }
 
 TEST(pal_timer, createTimerAutoStartPeriodic)
 {
-	timerCounter					 = 0;
-	pal_timer_environment.timer_list = nullptr;
-	pal_timer_t timer				 = {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 1, nullptr));
 	sleep(1);
 	EXPECT_EQ(3, timerCounter);
-	EXPECT_NE(nullptr, pal_timer_environment.timer_list);
+	EXPECT_NE(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 	pal_timer_deinit();
 }
 
+TEST(pal_timer, wheelTimerPeriodic)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_backend(&timer, PAL_TIMER_BACKEND_WHEEL));
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	EXPECT_EQ(-1, pal_timer_set_backend(&timer, PAL_TIMER_BACKEND_HEAP));
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
+	sleep(1);
+	EXPECT_EQ(3, timerCounter);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	EXPECT_EQ(0, pal_timer_environment[0].wheel_size);
+	sleep(1);
+	EXPECT_EQ(3, timerCounter);
+	pal_timer_deinit();
+}
+
+static int	slowCallbackDelayUs = 0;
+static int	slowCallbackCalls	= 0;
+static void slowTimerCallback(pal_timer_t *arg)
+{
+	timerCounter++;
+	if (slowCallbackCalls)
+	{
+		slowCallbackCalls--;
+		usleep(slowCallbackDelayUs);
+	}
+}
+
+TEST(pal_timer, periodicTimerNoDrift)
+{
+	timerCounter		= 0;
+	slowCallbackDelayUs = 4000;
+	slowCallbackCalls	= 1000;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	// Rescheduling from now would stretch every period by the callback runtime, to about 70 runs
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 10, slowTimerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_overrun_policy(&timer, PAL_TIMER_OVERRUN_CATCH_UP));
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	usleep(1005000);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	EXPECT_LE(93, timerCounter);
+	EXPECT_GE(100, timerCounter);
+	pal_timer_deinit();
+}
+
+// Runs a 20 ms periodic timer for 25 periods with a first callback stalling for more than five, returns the callback runs
+static int runStalledTimer(pal_timer_overrun_policy_t policy, size_t *overruns, size_t *periods)
+{
+	timerCounter		= 0;
+	slowCallbackDelayUs = 105000;
+	slowCallbackCalls	= 1;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 20, slowTimerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_overrun_policy(&timer, policy));
+	uint64_t start = nowUs();
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	usleep(510000);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	*periods  = (nowUs() - start) / 20000;
+	*overruns = pal_timer_get_overruns(&timer);
+	EXPECT_LE(4, *overruns);
+	pal_timer_deinit();
+	return timerCounter;
+}
+
+TEST(pal_timer, overrunPolicySkip)
+{
+	// The missed periods are dropped, the runs stay on the original grid
+	size_t overruns = 0;
+	size_t periods	= 0;
+	int	   count	= runStalledTimer(PAL_TIMER_OVERRUN_SKIP, &overruns, &periods);
+	EXPECT_LE(periods - 3, count + overruns);
+	EXPECT_GE(periods, count + overruns);
+}
+
+TEST(pal_timer, overrunPolicyCatchUp)
+{
+	// Every period runs, the missed ones back to back
+	size_t overruns = 0;
+	size_t periods	= 0;
+	int	   count	= runStalledTimer(PAL_TIMER_OVERRUN_CATCH_UP, &overruns, &periods);
+	EXPECT_LE(periods - 3, count);
+	EXPECT_GE(periods, count);
+}
+
+TEST(pal_timer, overrunPolicyCoalesce)
+{
+	// The missed periods are dropped and the grid restarts after the stall
+	size_t overruns = 0;
+	size_t periods	= 0;
+	int	   count	= runStalledTimer(PAL_TIMER_OVERRUN_COALESCE, &overruns, &periods);
+	EXPECT_GE(periods - 4, count);
+}
+
+static std::atomic<int> dispatchedRuns{0};
+static std::atomic<int> dispatchedInFlight{0};
+static std::atomic<int> dispatchedMaxInFlight{0};
+static int				dispatchedDelayUs = 35000;
+static void				dispatchedCallback(pal_timer_t *arg)
+{
+	int in_flight = ++dispatchedInFlight;
+	int max		  = dispatchedMaxInFlight;
+	while (in_flight > max && !dispatchedMaxInFlight.compare_exchange_weak(max, in_flight))
+	{
+	}
+	usleep(dispatchedDelayUs);
+	dispatchedRuns++;
+	dispatchedInFlight--;
+}
+
+TEST(pal_timer, dispatchPoolKeepsServiceResponsive)
+{
+	timerCounter	  = 0;
+	dispatchedRuns	  = 0;
+	dispatchedDelayUs = 100000;
+	pal_timer_deinit();
+	pal_timer_t slow   = {0};
+	pal_timer_t period = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&slow, "", PAL_TIMER_TYPE_PERIODIC, 10, dispatchedCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_dispatch(&slow, PAL_TIMER_DISPATCH_POOL, nullptr, 0));
+	EXPECT_EQ(-1, pal_timer_set_dispatch(&slow, PAL_TIMER_DISPATCH_QUEUE, nullptr, 0));
+	EXPECT_EQ(0, pal_timer_start(&slow));
+	EXPECT_EQ(-1, pal_timer_set_dispatch(&slow, PAL_TIMER_DISPATCH_SERVICE, nullptr, 0));
+	EXPECT_EQ(0, pal_timer_create(&period, "", PAL_TIMER_TYPE_PERIODIC, 10, timerCallback, 1, nullptr));
+	usleep(505000);
+	EXPECT_EQ(0, pal_timer_delete(&slow));
+	EXPECT_EQ(0, pal_timer_delete(&period));
+	// Running the slow callback on the service thread would leave the other timer about one run every 100 ms
+	EXPECT_LE(15, timerCounter);
+	EXPECT_LE(4, dispatchedRuns);
+	dispatchedDelayUs = 35000;
+	pal_timer_deinit();
+}
+
+static int runDispatchedInFlight(int concurrent)
+{
+	dispatchedRuns		  = 0;
+	dispatchedInFlight	  = 0;
+	dispatchedMaxInFlight = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 10, dispatchedCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_dispatch(&timer, PAL_TIMER_DISPATCH_POOL, nullptr, concurrent));
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	usleep(200000);
+	EXPECT_EQ(0, pal_timer_delete(&timer));
+	// Deleting waits for the callbacks still running
+	EXPECT_EQ(0, dispatchedInFlight);
+	pal_timer_deinit();
+	return dispatchedMaxInFlight;
+}
+
+TEST(pal_timer, dispatchPoolSerialized) { EXPECT_EQ(1, runDispatchedInFlight(0)); }
+
+TEST(pal_timer, dispatchPoolConcurrent) { EXPECT_EQ(PAL_TIMER_POOL_WORKERS, runDispatchedInFlight(1)); }
+
+TEST(pal_timer, dispatchQueue)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_queue_t queue = {};
+	pal_timer_t timer = {0};
+	EXPECT_EQ(0, pal_queue_create(&queue, sizeof(pal_timer_t *), 4));
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 20, timerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_dispatch(&timer, PAL_TIMER_DISPATCH_QUEUE, &queue, 0));
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	// The callbacks only run on the thread draining the queue
+	usleep(50000);
+	EXPECT_EQ(0, timerCounter);
+	pal_timer_t *dispatched = nullptr;
+	for (int i = 0; i < 5; i++)
+	{
+		EXPECT_EQ(0, pal_queue_dequeue(&queue, &dispatched, 1000));
+		EXPECT_EQ(&timer, dispatched);
+		EXPECT_EQ(0, pal_timer_run_dispatched(dispatched));
+	}
+	EXPECT_EQ(0, pal_timer_delete(&timer));
+	EXPECT_LE(5, timerCounter);
+	pal_timer_deinit();
+	pal_queue_destroy(&queue);
+}
+
+TEST(pal_timer, overrunPolicyInvalid)
+{
+	pal_timer_t timer = {0};
+	EXPECT_EQ(-1, pal_timer_set_overrun_policy(nullptr, PAL_TIMER_OVERRUN_SKIP));
+	EXPECT_EQ(-1, pal_timer_set_overrun_policy(&timer, (pal_timer_overrun_policy_t)3));
+	EXPECT_EQ(0, pal_timer_get_overruns(nullptr));
+}
+
+TEST(pal_timer, batchSharedDeadline)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	static pal_timer_t timers[500];
+	memset(timers, 0, sizeof(timers));
+	pal_timer_init();
+	for (int i = 0; i < 500; i++)
+	{
+		EXPECT_EQ(0, pal_timer_create(&timers[i], "", PAL_TIMER_TYPE_ONESHOT, 100, timerCallback, 1, nullptr));
+	}
+	usleep(500000);
+	EXPECT_EQ(500, timerCounter);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
+	EXPECT_EQ(nullptr, pal_timer_environment[0].expired_head);
+	pal_timer_deinit();
+}
+
+static void batchStopCallback(pal_timer_t *arg) { EXPECT_EQ(0, pal_timer_stop(arg)); }
+
+TEST(pal_timer, batchSkipsStoppedTimer)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t first  = {0};
+	pal_timer_t second = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&first, "", PAL_TIMER_TYPE_ONESHOT, 10, batchStopCallback, 1, &second));
+	EXPECT_EQ(0, pal_timer_create(&second, "", PAL_TIMER_TYPE_ONESHOT, 10, timerCallback, 1, nullptr));
+	// Holding the service past both deadlines expires them in one batch, the first callback stops the second one
+	pthread_mutex_lock(&pal_timer_environment[0].mutex);
+	usleep(30000);
+	pthread_mutex_unlock(&pal_timer_environment[0].mutex);
+	usleep(100000);
+	EXPECT_EQ(0, timerCounter);
+	EXPECT_EQ(0, pal_timer_delete(&first));
+	EXPECT_EQ(0, pal_timer_delete(&second));
+	pal_timer_deinit();
+}
+
+static std::atomic<int> serviceRunStarted{0};
+static std::atomic<int> serviceRunDone{0};
+static void				serviceSlowCallback(pal_timer_t *arg)
+{
+	serviceRunStarted = 1;
+	usleep(100000);
+	serviceRunDone = 1;
+}
+
+TEST(pal_timer, deleteWaitsForServiceCallback)
+{
+	serviceRunStarted = 0;
+	serviceRunDone	  = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 10, serviceSlowCallback, 1, nullptr));
+	for (int i = 0; i < 1000 && !serviceRunStarted; i++)
+	{
+		usleep(1000);
+	}
+	EXPECT_EQ(1, serviceRunStarted);
+	// The callback runs on the service thread, deleting its timer returns only once it is done
+	EXPECT_EQ(0, pal_timer_delete(&timer));
+	EXPECT_EQ(1, serviceRunDone);
+	pal_timer_deinit();
+}
+
+TEST(pal_timer, wakeupSource)
+{
+	for (int use_timerfd = 0; use_timerfd < 2; use_timerfd++)
+	{
+		timerCounter = 0;
+		pal_timer_deinit();
+		pal_timer_environment[0].use_timerfd = use_timerfd;
+		pal_timer_t timer					 = {0};
+		pal_timer_init();
+		// The service waits on a timerfd or on its condition variable, both wake it for the deadline
+		EXPECT_EQ(use_timerfd, pal_timer_environment[0].wakeup_fd >= 0);
+		EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 20, timerCallback, 1, nullptr));
+		usleep(300000);
+		EXPECT_EQ(1, timerCounter);
+		pal_timer_deinit();
+		pal_timer_environment[0].use_timerfd = PAL_TIMER_USE_TIMERFD;
+		EXPECT_EQ(-1, pal_timer_environment[0].wakeup_fd);
+	}
+}
+
+TEST(pal_timer, slackWindow)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 20, timerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_slack(&timer, 20));
+	EXPECT_EQ(20u, timer.slack_ms);
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	// The heap orders the timer by the end of its slack window
+	int64_t window_ns = (int64_t)(timer.latest_time.tv_sec - timer.expiry_time.tv_sec) * 1000000000 + (timer.latest_time.tv_nsec - timer.expiry_time.tv_nsec);
+	EXPECT_EQ(20000000, window_ns);
+	usleep(300000);
+	EXPECT_EQ(1, timerCounter);
+	pal_timer_deinit();
+	EXPECT_EQ(-1, pal_timer_set_slack(nullptr, 20));
+}
+
+TEST(pal_timer, microsecondPeriod)
+{
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
+	pal_timer_init();
+	EXPECT_LE(1u, pal_timer_get_resolution_us());
+	EXPECT_GE(250u, pal_timer_get_resolution_us());
+	EXPECT_EQ(-1, pal_timer_create_us(&timer, "", PAL_TIMER_TYPE_PERIODIC, 0, timerCallback, 0, nullptr));
+	// A millisecond period whose microsecond value does not fit is rejected instead of wrapping around to a short one
+	EXPECT_EQ(-1, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, SIZE_MAX / 1000 + 1, timerCallback, 0, nullptr));
+	// A 4 kHz sampling loop, the service wakes up 100 us early and spins for the exact deadline
+	EXPECT_EQ(0, pal_timer_create_us(&timer, "", PAL_TIMER_TYPE_PERIODIC, 250, timerCallback, 0, nullptr));
+	EXPECT_EQ(250u, timer.period_us);
+	EXPECT_EQ(0, pal_timer_set_spin(&timer, 100));
+	EXPECT_EQ(0, pal_timer_start(&timer));
+	usleep(100000);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	EXPECT_LT(0, timerCounter);
+	EXPECT_EQ(-1, pal_timer_change_period_us(&timer, 0));
+	EXPECT_EQ(0, pal_timer_change_period_us(&timer, 1000));
+	EXPECT_EQ(1000u, timer.period_us);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	// The millisecond API keeps the period in microseconds too
+	EXPECT_EQ(-1, pal_timer_change_period(&timer, SIZE_MAX / 1000 + 1));
+	EXPECT_EQ(1000u, timer.period_us);
+	EXPECT_EQ(0, pal_timer_change_period(&timer, 5));
+	EXPECT_EQ(5000u, timer.period_us);
+	EXPECT_EQ(0, pal_timer_stop(&timer));
+	EXPECT_EQ(-1, pal_timer_set_spin(nullptr, 100));
+	pal_timer_deinit();
+}
+
+static void shardCallback(pal_timer_t *arg) { *(pthread_t *)arg = pthread_self(); }
+
+TEST(pal_timer, shardedService)
+{
+	pal_timer_deinit();
+	EXPECT_EQ(-1, pal_timer_set_shards(0));
+	EXPECT_EQ(-1, pal_timer_set_shards(PAL_TIMER_MAX_SHARDS + 1));
+	ASSERT_EQ(0, pal_timer_set_shards(4));
+	pal_timer_init();
+	EXPECT_EQ(-1, pal_timer_set_shards(2));
+	pal_timer_t timers[4]  = {};
+	pthread_t	threads[4] = {};
+	for (size_t i = 0; i < 4; i++)
+	{
+		EXPECT_NE(0, pal_timer_environment[i].thread_handle);
+		EXPECT_EQ(0, pal_timer_create(&timers[i], "", PAL_TIMER_TYPE_ONESHOT, 20, shardCallback, 0, &threads[i]));
+		// A new timer is served by the shard of the CPU creating it
+		EXPECT_GT(4u, timers[i].shard);
+		EXPECT_EQ(0, pal_timer_set_shard(&timers[i], i));
+		EXPECT_EQ(0, pal_timer_start(&timers[i]));
+		EXPECT_EQ(-1, pal_timer_set_shard(&timers[i], 0));
+	}
+	EXPECT_EQ(-1, pal_timer_set_shard(&timers[0], 4));
+	for (size_t i = 0; i < 4; i++)
+	{
+		// Each shard schedules its own timers
+		EXPECT_EQ(1, pal_timer_environment[i].heap_size);
+	}
+	usleep(200000);
+	for (size_t i = 0; i < 4; i++)
+	{
+		EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[i]));
+		EXPECT_TRUE(pthread_equal(pal_timer_environment[i].thread_handle, threads[i]));
+		// Creating a timer again keeps the shard it was moved to
+		EXPECT_EQ(0, pal_timer_create(&timers[i], "", PAL_TIMER_TYPE_ONESHOT, 20, shardCallback, 0, &threads[i]));
+		EXPECT_EQ(i, timers[i].shard);
+	}
+	// Moving a pool timer starts the pool of its new shard
+	pal_timer_t pooled = {0};
+	EXPECT_EQ(0, pal_timer_set_shard(&pooled, 3));
+	EXPECT_EQ(0, pal_timer_set_dispatch(&pooled, PAL_TIMER_DISPATCH_POOL, nullptr, 0));
+	EXPECT_EQ(0, pal_timer_environment[2].pool_size);
+	EXPECT_EQ(0, pal_timer_set_shard(&pooled, 2));
+	EXPECT_NE(0, pal_timer_environment[2].pool_size);
+	EXPECT_EQ(0, pal_timer_create(&pooled, "", PAL_TIMER_TYPE_ONESHOT, 20, timerCallback, 0, nullptr));
+	EXPECT_EQ(2, pooled.shard);
+	pal_timer_deinit();
+	EXPECT_EQ(0, pal_timer_set_shards(1));
+	for (size_t i = 0; i < PAL_TIMER_MAX_SHARDS; i++)
+	{
+		EXPECT_EQ(0, pal_timer_environment[i].thread_handle);
+	}
+}
+
+TEST(pal_timer, restartWhileMovingShards)
+{
+	pal_timer_deinit();
+	ASSERT_EQ(0, pal_timer_set_shards(2));
+	pal_timer_init();
+	pal_timer_t timer = {0};
+	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 10000, timerCallback, 0, nullptr));
+	EXPECT_EQ(0, pal_timer_set_shard(&timer, 0));
+	// The test moves the timer the way pal_timer_set_shard does, with both shards locked, while a restart waits for the old shard
+	pthread_mutex_lock(&pal_timer_environment[0].mutex);
+	pthread_mutex_lock(&pal_timer_environment[1].mutex);
+	std::thread restarter([&]() { EXPECT_EQ(0, pal_timer_restart(&timer)); });
+	usleep(50000);
+	timer.shard = 1;
+	pthread_mutex_unlock(&pal_timer_environment[0].mutex);
+	usleep(50000);
+	// The restart finds the timer moved and waits for its new shard instead of arming it under the old lock
+	EXPECT_EQ(0u, pal_timer_environment[1].heap_size);
+	pthread_mutex_unlock(&pal_timer_environment[1].mutex);
+	restarter.join();
+	EXPECT_EQ(0u, pal_timer_environment[0].heap_size);
+	EXPECT_EQ(1u, pal_timer_environment[1].heap_size);
+	EXPECT_EQ(0, pal_timer_delete(&timer));
+	pal_timer_deinit();
+	EXPECT_EQ(0, pal_timer_set_shards(1));
+}
+
 TEST(pal_timer, createTimerNoAutoStartOneShot)
 {
-	timerCounter						= 0;
-	pal_timer_environment.timer_list	= nullptr;
-	pal_timer_environment.shutdown_flag = 0;
-	pal_timer_t timer					= {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_environment[0].shutdown_flag = 0;
+	pal_timer_t timer					   = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 100, timerCallback, 0, nullptr));
 	sleep(1);
@@ -257,16 +782,16 @@ TEST(pal_timer, createTimerNoAutoStartOneShot)
 	EXPECT_EQ(0, pal_timer_start(&timer));
 	sleep(1);
 	EXPECT_EQ(1, timerCounter);
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 	pal_timer_deinit();
 }
 
 TEST(pal_timer, stopPeriodicTimer)
 {
-	timerCounter						= 0;
-	pal_timer_environment.timer_list	= nullptr;
-	pal_timer_environment.shutdown_flag = 0;
-	pal_timer_t timer					= {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_environment[0].shutdown_flag = 0;
+	pal_timer_t timer					   = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 0, nullptr));
 	sleep(1);
@@ -275,7 +800,7 @@ TEST(pal_timer, stopPeriodicTimer)
 	sleep(1);
 	EXPECT_EQ(3, timerCounter);
 	EXPECT_EQ(0, pal_timer_stop(&timer));
-	EXPECT_EQ(nullptr, pal_timer_environment.timer_list);
+	EXPECT_EQ(nullptr, pal_os_timer_heap_top(&pal_timer_environment[0]));
 	sleep(1);
 	EXPECT_EQ(3, timerCounter);
 	EXPECT_EQ(0, pal_timer_start(&timer));
@@ -298,10 +823,10 @@ TEST(pal_timer, startTimerNullPtrFailure) { EXPECT_EQ(-1, pal_timer_start(nullpt
 
 TEST(pal_timer, restartOneShotTimer)
 {
-	timerCounter						= 0;
-	pal_timer_environment.timer_list	= nullptr;
-	pal_timer_environment.shutdown_flag = 0;
-	pal_timer_t timer					= {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_environment[0].shutdown_flag = 0;
+	pal_timer_t timer					   = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 100, timerCallback, 0, nullptr));
 	pal_timer_start(&timer);
@@ -315,10 +840,10 @@ TEST(pal_timer, restartOneShotTimer)
 
 TEST(pal_timer, changePeriodOneShotTimer)
 {
-	timerCounter						= 0;
-	pal_timer_environment.timer_list	= nullptr;
-	pal_timer_environment.shutdown_flag = 0;
-	pal_timer_t timer					= {0};
+	timerCounter = 0;
+	pal_timer_deinit();
+	pal_timer_environment[0].shutdown_flag = 0;
+	pal_timer_t timer					   = {0};
 	pal_timer_init();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_ONESHOT, 100, timerCallback, 1, nullptr));
 	sleep(1);
@@ -331,22 +856,22 @@ TEST(pal_timer, changePeriodOneShotTimer)
 
 TEST(pal_timer, changePeriodWith0Failure)
 {
-	pal_timer_t timer				 = {0};
-	pal_timer_environment.timer_list = nullptr;
+	pal_timer_t timer = {0};
+	pal_timer_deinit();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 1, nullptr));
 	EXPECT_EQ(-1, pal_timer_change_period(&timer, 0));
 }
 
 TEST(pal_timer, changePeriodWithNullPtrFailure)
 {
-	pal_timer_environment.timer_list = nullptr;
+	pal_timer_deinit();
 	EXPECT_EQ(-1, pal_timer_change_period(nullptr, 300));
 }
 
 TEST(pal_timer, isTimerActiveNoAutoStart)
 {
-	pal_timer_environment.timer_list = nullptr;
-	pal_timer_t timer				 = {0};
+	pal_timer_deinit();
+	pal_timer_t timer = {0};
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 0, nullptr));
 	EXPECT_EQ(0, pal_is_timer_active(&timer));
 	EXPECT_EQ(0, pal_timer_start(&timer));
@@ -356,8 +881,8 @@ TEST(pal_timer, isTimerActiveNoAutoStart)
 
 TEST(pal_timer, isTimerActiveAutoStart)
 {
-	pal_timer_t timer				 = {0};
-	pal_timer_environment.timer_list = nullptr;
+	pal_timer_t timer = {0};
+	pal_timer_deinit();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 1, nullptr));
 	EXPECT_EQ(1, pal_is_timer_active(&timer));
 	EXPECT_EQ(0, pal_timer_stop(&timer));
@@ -369,14 +894,14 @@ TEST(pal_timer, isTimerActiveAutoStart)
 
 TEST(pal_timer, timerDeleteSuccess)
 {
-	pal_timer_t timer				 = {0};
-	pal_timer_environment.timer_list = nullptr;
+	pal_timer_t timer = {0};
+	pal_timer_deinit();
 	EXPECT_EQ(0, pal_timer_create(&timer, "", PAL_TIMER_TYPE_PERIODIC, 300, timerCallback, 1, nullptr));
 	EXPECT_EQ(0, pal_timer_delete(&timer));
 }
 
 TEST(pal_timer, timerDeleteNullPtrFailure)
 {
-	pal_timer_environment.timer_list = nullptr;
+	pal_timer_deinit();
 	EXPECT_EQ(-1, pal_timer_delete(nullptr));
 }
\ No newline at end of file